@@ -20,6 +20,7 @@
 
 #include "../src/api.hpp"
 #include "../src/error.hpp"
+#include "../src/profiler.hpp"
 
 #include <cstdint>
 #include <functional>
@@ -87,6 +88,8 @@ struct Safe<fn, Meta>
     // not when reentering (eg. EEL Function callback) so that we can still
     // check for previous failure using API::lastError
     API::ErrorClearer reentrant {};
+    API::CallScope scope {Meta::name};
+    PROFILE_ZONE(Meta::name);
     return std::invoke(fn, args...);
   }
   catch(const imgui_error &e) {
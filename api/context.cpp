@@ -17,6 +17,7 @@
 
 #include "helper.hpp"
 
+#include <imgui/imgui_internal.h> // ImGuiWindow
 #include <variant>
 
 API_SECTION("Context");
@@ -27,9 +28,15 @@ R"(Create a new ReaImGui context.
 The context will remain valid as long as it is used in each defer cycle.
 
 The label is used for the tab text when windows are docked in REAPER
-and also as a unique identifier for storing settings.)")
+and also as a unique identifier for storing settings.
+
+Takes over a hibernating context previously created with the same label if any
+(see SetHibernationPeriod).)")
 {
-  return new Context {label, API_GET(config_flags)};
+  const int flags {API_GET(config_flags)};
+  if(Context *ctx {Context::adopt(label, flags)})
+    return ctx;
+  return new Context {label, flags};
 }
 
 API_FUNC(0_1, double, GetTime, (Context*,ctx),
@@ -61,6 +68,201 @@ GetDeltaTime), in frame per second. Solely for convenience.)")
   return ctx->IO().Framerate;
 }
 
+API_FUNC(0_10_1, void, SetFrameRateLimit, (Context*,ctx)
+(double,fps) (RO<double*>,background_fps,-1.0),
+R"(Limit how often the context starts a new frame. 'background_fps' is used
+instead while none of the context's windows has keyboard focus or is under the
+mouse cursor. A value of 0 means unlimited, for either rate. 'background_fps'
+is the same as 'fps' when omitted or negative.
+
+The limit is enforced by the script: call IsFrameThrottled at the start of
+each defer cycle and skip the UI code when it returns true. The windows keep
+displaying their previous frame and user input is not lost.)")
+{
+  assertValid(ctx);
+
+  if(fps < 0)
+    throw reascript_error {"frame rate limit must not be negative"};
+
+  const double background {API_GET(background_fps)};
+  ctx->setFrameRateLimit(fps, background < 0 ? fps : background);
+}
+
+API_FUNC(0_10_1, bool, IsFrameThrottled, (Context*,ctx),
+R"(Whether the frame rate limit set using SetFrameRateLimit wants this defer
+cycle to be skipped. Calling this function keeps the context alive even if
+no frame is started. Always returns false once a frame was started.)")
+{
+  assertValid(ctx);
+  return !ctx->isFrameDue();
+}
+
+API_FUNC(0_10_1, bool, IsContextVisible, (Context*,ctx),
+R"(Whether any of the context's windows can currently be seen: false when they
+are all minimized, docked in inactive tabs or shrunk to nothing. Such windows
+are not rendered. Returns true until the context's first frame has been
+rendered.
+
+Windows must still be submitted using Begin/End to keep them open, but their
+contents can be skipped while this returns false. Windows fully covered by
+other windows are considered visible. Calling this function keeps the context
+alive even if no frame is started.)")
+{
+  assertValid(ctx);
+  return ctx->isVisible();
+}
+
+API_FUNC(0_10_1, void, SetHibernationPeriod, (Context*,ctx) (double,seconds),
+R"(Keep the context in memory for up to 'seconds' once it is no longer used
+(eg. when the script is stopped or restarted) instead of destroying it.
+CreateContext called with the same label and SharedFonts flag during that time
+returns a new context taking over the hibernating one. The new context keeps:
+
+- the window settings (positions, sizes, docking layout) and style
+- the configuration variables (see SetConfigVar)
+- the fonts and their textures
+- the renderer's shared resources (shaders, etc)
+
+Everything else starts over as in a new context: the configuration flags given
+to CreateContext, SetFrameRateLimit, SetCachePolicy, SetHibernationPeriod and
+the statistics. Hibernating contexts close their windows and detach their
+attached objects. The textures of images are not reused.
+
+The hibernating context is destroyed by the takeover: its previous user
+cannot use it again. Defaults to 0 (destroy immediately).)")
+{
+  assertValid(ctx);
+  if(seconds < 0)
+    throw reascript_error {"hibernation period must not be negative"};
+  ctx->setHibernationPeriod(seconds);
+}
+
+API_FUNC(0_10_1, void, GetRenderStats, (Context*,ctx)
+(W<int*>,rendered) (W<int*>,skipped) (W<int*>,deferred),
+R"(Number of frames rendered by each window (viewport) of the context since its
+creation. Frames identical to the previous one (same draw commands and no
+texture changes) are skipped instead of being rendered and presented again.
+
+'deferred' is the number of frames of the context whose presentation was
+postponed to the next defer cycle to limit the time REAPER spends rendering
+all contexts. The context under the mouse cursor or having keyboard focus is
+never postponed.)")
+{
+  assertValid(ctx);
+
+  const Context::RenderStats &stats {ctx->renderStats()};
+  if(rendered) *rendered = stats.rendered;
+  if(skipped)  *skipped  = stats.skipped;
+  if(deferred) *deferred = stats.deferred;
+}
+
+API_FUNC(0_10_1, int, GetFrameStats, (Context*,ctx) (reaper_array*,values),
+R"(Timing of the phases of the last frames of the context (up to 120).
+Returns the number of frames sampled.
+
+The array receives the minimum, average and 99th percentile duration in
+milliseconds of each phase, in this order (30 values):
+UpdateMonitors, UpdateInputs, NewFrame, Dockers, Script (time between the
+beginning and the end of the frame, including other scripts running in the
+same defer cycle), UpdateSubresources, Render, UpdatePlatformWindows,
+RenderPlatformWindows and CleanupTextures.
+
+Frames postponed to limit the total rendering time (see GetRenderStats) have
+their ending time counted in Render.)")
+{
+  assertValid(ctx);
+  assertValid(values);
+
+  constexpr int size {Context::FramePhaseCount * 3};
+  if(values->size < size)
+    throw reascript_error {"array size must be at least {}", size};
+
+  std::array<Context::PhaseStats, Context::FramePhaseCount> stats;
+  const unsigned int frames {ctx->frameStats(&stats)};
+  double *out {values->data};
+  for(const Context::PhaseStats &phase : stats) {
+    *out++ = phase.min * 1000;
+    *out++ = phase.avg * 1000;
+    *out++ = phase.p99 * 1000;
+  }
+
+  return frames;
+}
+
+API_FUNC(0_10_1, int, GetInputLatency, (Context*,ctx)
+(W<double*>,p50) (W<double*>,p90) (W<double*>,p99) (W<double*>,max),
+R"(Time in milliseconds from mouse, keyboard or text input events reaching the
+context's windows to the presentation of the first frame using them, over the
+last 120 samples. Returns the number of samples.
+
+Only frames where a viewport's contents changed are sampled. This includes
+the wait for the next defer cycle and the script's own frame time but not the
+compositor's delay after the buffers are swapped.)")
+{
+  assertValid(ctx);
+
+  Context::LatencyStats stats;
+  const unsigned int samples {ctx->inputLatency(&stats)};
+  if(p50) *p50 = stats.p50 * 1000;
+  if(p90) *p90 = stats.p90 * 1000;
+  if(p99) *p99 = stats.p99 * 1000;
+  if(max) *max = stats.max * 1000;
+
+  return samples;
+}
+
+API_FUNC(0_10_1, void, GetMemoryStats, (Context*,ctx)
+(W<double*>,bytes) (W<int*>,blocks) (W<double*>,reserved)
+(W<double*>,allocations),
+R"(Memory allocated by Dear ImGui on behalf of the context. 'bytes' and
+'blocks' are the size and number of live allocations, 'reserved' is the total
+size of the memory pools they are carved from. 'allocations' is cumulative
+since the creation of the context.
+
+Allocations are attributed to the context that was current when they were
+made: a font atlas shared between contexts is counted in the one that built
+it.)")
+{
+  assertValid(ctx);
+
+  const Arena::Stats &stats {ctx->memoryStats()};
+  if(bytes)       *bytes       = stats.bytes;
+  if(blocks)      *blocks      = stats.blocks;
+  if(reserved)    *reserved    = stats.reserved;
+  if(allocations) *allocations = stats.allocations;
+}
+
+API_FUNC(0_10_1, bool, GetDrawListMemory, (Context*,ctx)
+(int,index) (W<char*>,window) (WS<int>,window_sz)
+(W<double*>,bytes) (W<double*>,reserved),
+R"(Enumerate the windows of the context (including child windows, popups and
+tooltips) along with the size of their draw list as of the last frame they
+were drawn. 'reserved' includes the unused capacity kept for the next frames.
+Returns false if index is out of bounds.
+
+Buffers of windows still drawn but using much less than their capacity are
+shrunk every 600 frames. Dear ImGui releases those of windows that are no
+longer drawn after a while.)")
+{
+  assertValid(ctx);
+
+  const ImVector<ImGuiWindow *> &windows {ctx->imgui()->Windows};
+  if(index < 0 || index >= windows.Size)
+    return false;
+
+  const ImGuiWindow *imguiWindow {windows[index]};
+  const Context::DrawListMemory memory
+    {Context::drawListMemory(imguiWindow->DrawList)};
+  if(window)
+    snprintf(window, window_sz, "%s", imguiWindow->Name);
+  if(bytes)
+    *bytes = memory.bytes;
+  if(reserved)
+    *reserved = memory.reserved;
+
+  return true;
+}
+
 API_FUNC(0_8, void, Attach, (Context*,ctx) (Resource*,obj),
 R"(Link the object's lifetime to the given context.
 Objects can be draw list splitters, fonts, images, list clippers, etc.
@@ -83,6 +285,59 @@ ValidatePtr.)")
   ctx->detach(obj);
 }
 
+API_SUBSECTION("Cache",
+R"(Each context keeps its own copy of the images (as textures) and fonts it uses.
+Copies are released after being unused for a number of frames, or earlier
+(least recently used first) when their total size exceeds the budget.
+Copies used during the current frame are never released early.)");
+
+API_FUNC(0_10_1, void, SetCachePolicy, (Context*,ctx)
+(RO<int*>,ttl_frames,120) (RO<double*>,budget_bytes,0),
+R"(Set how many frames unused copies are kept and the maximum total size of
+the cache in bytes (0 for no limit). Use a longer TTL for contexts that are
+only drawn occasionally. See GetCacheStats.)")
+{
+  assertValid(ctx);
+
+  const int ttl {API_GET(ttl_frames)};
+  const double budget {API_GET(budget_bytes)};
+  if(ttl < 1 || ttl > Context::MAX_SUBRESOURCE_TTL)
+    throw reascript_error
+      {"TTL must be between 1 and {} frames", Context::MAX_SUBRESOURCE_TTL};
+  else if(budget < 0)
+    throw reascript_error {"budget must not be negative"};
+
+  ctx->setSubresourcePolicy(ttl, budget);
+}
+
+API_FUNC(0_10_1, void, GetCachePolicy, (Context*,ctx)
+(W<int*>,ttl_frames) (W<double*>,budget_bytes),
+"See SetCachePolicy.")
+{
+  assertValid(ctx);
+
+  if(ttl_frames)   *ttl_frames   = ctx->subresourceTTL();
+  if(budget_bytes) *budget_bytes = ctx->subresourceBudget();
+}
+
+API_FUNC(0_10_1, void, GetCacheStats, (Context*,ctx)
+(W<int*>,hits) (W<int*>,installs) (W<int*>,evictions)
+(W<int*>,count) (W<double*>,bytes),
+R"('hits', 'installs' and 'evictions' are cumulative since the creation of the
+context. Evictions include both expired and over budget copies.
+'count' and 'bytes' are the number and approximate size of the copies held
+as of the last frame.)")
+{
+  assertValid(ctx);
+
+  const Context::SubresourceStats &stats {ctx->subresourceStats()};
+  if(hits)      *hits      = stats.hits;
+  if(installs)  *installs  = stats.installs;
+  if(evictions) *evictions = stats.evictions;
+  if(count)     *count     = stats.count;
+  if(bytes)     *bytes     = stats.bytes;
+}
+
 API_SUBSECTION("Options",
   "You can visualize and interact with all options in Demo > Configuration");
 
@@ -340,3 +595,11 @@ This is done by ignoring keyboard events and clearing existing states.)");
 
 API_ENUM_NS(0_4, ReaImGui, ConfigFlags_NoSavedSettings,
   "Disable state restoration and persistence for the whole context.");
+API_ENUM_NS(0_10_1, ReaImGui, ConfigFlags_LowLatency,
+R"(Render frames as soon as the deferred scripts of the current defer cycle
+   have run instead of on the next timer tick. Frames of such contexts are
+   never postponed to limit the total rendering time (see GetRenderStats).)");
+API_ENUM_NS(0_10_1, ReaImGui, ConfigFlags_SharedFonts,
+R"(Use a font atlas shared with the other contexts created with this flag.
+   Glyphs of fonts used by several of these contexts (including the default
+   font) are rasterized only once. Only effective when given to CreateContext.)");
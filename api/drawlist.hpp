@@ -22,6 +22,7 @@
 
 #include "../src/resource_proxy.hpp"
 #include "../src/context.hpp"
+#include "../src/slab.hpp"
 
 struct DrawListProxy : ResourceProxy<DrawListProxy, Context, ImDrawList> {
   template<Key KeyValue, auto GetterFunc>
@@ -46,7 +47,7 @@ struct DrawListProxy : ResourceProxy<DrawListProxy, Context, ImDrawList> {
 
 API_REGISTER_TYPE(DrawListProxy*, "ImGui_DrawList*");
 
-class DrawListSplitter : public Resource {
+class DrawListSplitter : public Resource, public Pooled {
 public:
   DrawListSplitter(DrawListProxy *);
   ImDrawList *drawList() const;
@@ -213,7 +213,8 @@ void assertValid(Tag<T, tags> ptr)
   assertValid(static_cast<T>(ptr));
 }
 
-inline void assertFrame(Context *ctx)
+template<typename Ctx>
+void assertFrame(Ctx *ctx)
 {
   if(!ctx->enterFrame()) {
     delete ctx;
@@ -221,7 +222,27 @@ inline void assertFrame(Context *ctx)
   }
 }
 
-#define FRAME_GUARD assertValid(ctx); assertFrame(ctx)
+// Skip validating the context and entering its frame when it already went
+// through here and no frame ended nor any context was destroyed since.
+// (Ctx is always Context outside of the tests.)
+template<typename Ctx>
+void frameGuard(Ctx *ctx)
+{
+  static Ctx *lastContext;
+  static unsigned int lastEpoch;
+
+  if(ctx && ctx == lastContext && lastEpoch == Ctx::frameEpoch() &&
+      ImGui::GetCurrentContext() == ctx->imgui())
+    return;
+
+  assertValid(ctx);
+  assertFrame(ctx);
+
+  lastContext = ctx;
+  lastEpoch = Ctx::frameEpoch();
+}
+
+#define FRAME_GUARD frameGuard(ctx)
 
 template <typename PtrType, typename ValType, size_t N>
 class ReadWriteArray {
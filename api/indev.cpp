@@ -337,6 +337,91 @@ R"(Request capture of keyboard shortcuts in REAPER's global scope for the next f
   ImGui::SetNextFrameWantCaptureKeyboard(want_capture_keyboard);
 }
 
+API_SECTION_DEF(frameState, ROOT_SECTION, "Frame State");
+
+constexpr int FRAME_STATE_VERSION {1}, FRAME_STATE_FIELDS {27},
+  FRAME_STATE_KEY_WORDS {(ImGuiKey_NamedKey_COUNT + 31) / 32},
+  FRAME_STATE_SIZE {FRAME_STATE_FIELDS + FRAME_STATE_KEY_WORDS};
+// the key bits are part of the layout: any change to the named keys must bump
+// FRAME_STATE_VERSION and update GetFrameState's documentation
+static_assert(ImGuiKey_NamedKey_BEGIN == 512 && ImGuiKey_Tab == 512 &&
+  ImGuiKey_NamedKey_COUNT == 155 && FRAME_STATE_KEY_WORDS == 5,
+  "named keys changed: update the GetFrameState layout");
+
+API_FUNC(0_10_1, int, GetFrameState, (Context*,ctx) (reaper_array*,values),
+R"(Read the mouse, keyboard and current window state in one call. Returns the
+version of the layout (currently 1). The array must hold at least 32 values:
+
+- 0: GetTime, 1: GetDeltaTime, 2: GetFrameCount
+- 3, 4: GetMousePos
+- 5, 6: GetMouseDelta
+- 7, 8: GetMouseWheel (vertical, horizontal)
+- 9, 10, 11: mouse buttons down, clicked and released this frame
+  (bit n = button n)
+- 12: GetKeyMods
+- 13, 14, 15: WantCaptureMouse, WantCaptureKeyboard and WantTextInput
+- 16, 17: GetWindowPos
+- 18, 19: GetWindowSize
+- 20, 21: GetContentRegionAvail
+- 22, 23: GetCursorScreenPos
+- 24, 25, 26: IsWindowFocused, IsWindowHovered and IsWindowAppearing
+  (default flags)
+- 27 to 31: keys down, 32 per value. The state of a key is in bit
+  (key - Key_Tab) % 32 of value 27 + (key - Key_Tab) // 32.
+
+Booleans are 0 or 1. Window values refer to the window being appended to.)")
+{
+  FRAME_GUARD;
+  assertValid(values);
+
+  if(values->size < FRAME_STATE_SIZE)
+    throw reascript_error {"array size must be at least {}", FRAME_STATE_SIZE};
+
+  const ImGuiIO &io {ctx->IO()};
+  double *out {values->data};
+  *out++ = ImGui::GetTime();
+  *out++ = io.DeltaTime;
+  *out++ = ImGui::GetFrameCount();
+  *out++ = io.MousePos.x;
+  *out++ = io.MousePos.y;
+  *out++ = io.MouseDelta.x;
+  *out++ = io.MouseDelta.y;
+  *out++ = io.MouseWheel;
+  *out++ = io.MouseWheelH;
+  int down {}, clicked {}, released {};
+  for(int button {}; button < ImGuiMouseButton_COUNT; ++button) {
+    const int bit {1 << button};
+    if(ImGui::IsMouseDown(button))     down     |= bit;
+    if(ImGui::IsMouseClicked(button))  clicked  |= bit;
+    if(ImGui::IsMouseReleased(button)) released |= bit;
+  }
+  *out++ = down;
+  *out++ = clicked;
+  *out++ = released;
+  *out++ = io.KeyMods;
+  *out++ = io.WantCaptureMouse;
+  *out++ = io.WantCaptureKeyboard;
+  *out++ = io.WantTextInput;
+  for(const ImVec2 &vec : {ImGui::GetWindowPos(), ImGui::GetWindowSize(),
+      ImGui::GetContentRegionAvail(), ImGui::GetCursorScreenPos()}) {
+    *out++ = vec.x;
+    *out++ = vec.y;
+  }
+  *out++ = ImGui::IsWindowFocused();
+  *out++ = ImGui::IsWindowHovered();
+  *out++ = ImGui::IsWindowAppearing();
+
+  unsigned int keys[FRAME_STATE_KEY_WORDS] {};
+  for(int i {}; i < ImGuiKey_NamedKey_COUNT; ++i) {
+    if(ImGui::IsKeyDown(static_cast<ImGuiKey>(ImGuiKey_NamedKey_BEGIN + i)))
+      keys[i / 32] |= 1u << (i % 32);
+  }
+  for(const unsigned int word : keys)
+    *out++ = word;
+
+  return FRAME_STATE_VERSION;
+}
+
 API_SECTION_DEF(namedKeys, keyboard, "Named Keys");
 API_SECTION_P(namedKeys, "Keyboard");
 API_ENUM(0_6, Key_Tab,        "");
@@ -19,8 +19,9 @@
 #define REAIMGUI_LISTCLIPPER_HPP
 
 #include "../src/resource.hpp"
+#include "../src/slab.hpp"
 
-class ListClipper final : public Resource {
+class ListClipper final : public Resource, public Pooled {
 public:
   ListClipper(Context *);
   ~ListClipper();
@@ -19,8 +19,9 @@
 #define REAIMGUI_TEXTFILTER_HPP
 
 #include "../src/resource.hpp"
+#include "../src/slab.hpp"
 
-class TextFilter : public Resource {
+class TextFilter : public Resource, public Pooled {
 public:
   TextFilter(const char *filter);
   void set(const char *filter);
@@ -28,6 +28,7 @@
 #include "../src/function.hpp"
 #include "../src/image.hpp"
 #include "../src/platform.hpp"
+#include "../src/trace.hpp"
 
 #include <climits>
 #include <reaper_plugin_functions.h>
@@ -150,6 +151,87 @@ NUMERIC_LIMITS(0_8_4, Double, double, DBL_MIN, DBL_MAX);
 NUMERIC_LIMITS(0_4,   Float,  double, FLT_MIN, FLT_MAX);
 NUMERIC_LIMITS(0_8_4, Int,    int,    INT_MIN, INT_MAX);
 
+API_SUBSECTION("Resource Census",
+R"(Diagnostics for finding which script or API function is holding onto or
+repeatedly creating objects. See also the "ReaImGui" section in
+ShowMetricsWindow.)");
+
+API_FUNC(0_10_1, bool, GetResourceCensus,
+(int,index) (W<char*>,type) (WS<int>,type_sz)
+(W<char*>,creator) (WS<int>,creator_sz)
+(W<int*>,count) (W<double*>,bytes),
+R"(Enumerate live objects (from all scripts) grouped by type and by the API
+function that created them. 'bytes' is an approximation of the memory owned
+by the objects such as image pixels or font data loaded from memory.
+'creator' is empty for objects created internally.
+
+The list is updated once per defer cycle. Returns false if index is out of
+bounds.)")
+{
+  const auto &census {Resource::census()};
+  if(index < 0 || static_cast<size_t>(index) >= census.size())
+    return false;
+
+  const Resource::CensusRow &row {census[index]};
+  if(type)
+    snprintf(type, type_sz, "%s", row.type.c_str());
+  if(creator)
+    snprintf(creator, creator_sz, "%s", row.creator ? row.creator : "");
+  if(count)
+    *count = row.count;
+  if(bytes)
+    *bytes = row.bytes;
+
+  return true;
+}
+
+API_FUNC(0_10_1, bool, GetResourceChurn,
+(W<int*>,created) (W<int*>,collected) (W<int*>,gc_frames)
+(RO<int*>,ticks_ago,0),
+R"(Number of objects created and garbage-collected during a past defer cycle.
+'gc_frames' is the number of consecutive cycles in which objects were
+collected, creating new objects fails when it reaches 120.
+
+History is kept for the last 120 cycles. Returns false if 'ticks_ago' is out
+of bounds.)")
+{
+  const int ago {API_GET(ticks_ago)};
+  const Resource::ChurnSample *sample
+    {ago < 0 ? nullptr : Resource::churn(ago)};
+  if(!sample)
+    return false;
+
+  if(created)   *created   = sample->created;
+  if(collected) *collected = sample->collected;
+  if(gc_frames) *gc_frames = sample->gcFrames;
+
+  return true;
+}
+
+API_SUBSECTION("Performance Trace",
+R"(Timeline of the work done by ReaImGui in every context (frame phases,
+rendering, texture uploads, image decoding, font fallback lookup) viewable in
+chrome://tracing or https://ui.perfetto.dev. Recording can also be toggled
+using the "ReaImGui: Record a performance trace (toggle)" action.)");
+
+API_FUNC(0_10_1, bool, ToggleTrace,
+(W<char*>,file) (WS<int>,file_sz),
+R"(Start recording a trace or stop the recording in progress. When stopping,
+the trace is written to a new file in REAPER's resource directory and its path
+is returned in 'file'. Returns whether a recording is now in progress.)")
+{
+  if(!Trace::isRecording()) {
+    Trace::start();
+    return true;
+  }
+
+  const std::string path {Trace::stop()};
+  if(file)
+    snprintf(file, file_sz, "%s", path.c_str());
+
+  return false;
+}
+
 API_SUBSECTION("ID Stack/Scope",
 R"(Read the [FAQ](https://dearimgui.com/faq) for more details about how IDs are
 handled in dear imgui.
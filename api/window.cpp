@@ -23,7 +23,8 @@
 
 #include "../src/api_eel.hpp"
 
-#include <imgui/imgui.h>
+#include <algorithm>
+#include <imgui/imgui_internal.h> // ImGuiWindow
 
 API_SECTION("Window",
 R"(Functions for creating and manipulating windows.
@@ -606,15 +607,158 @@ Display ReaImGui version, Dear ImGui version, credits and build/system informati
   ImGui::ShowAboutWindow(); // appends to the same window by title
 }
 
+static void showResourceMetrics()
+{
+  const auto &census {Resource::census()};
+  size_t count {}, bytes {};
+  for(const Resource::CensusRow &row : census)
+    count += row.count, bytes += row.bytes;
+
+  if(!ImGui::TreeNode("Resources", "Resources (%zu objects, %zu bytes)",
+      count, bytes))
+    return;
+
+  constexpr ImGuiTableFlags tableFlags {ImGuiTableFlags_Borders |
+    ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit};
+  if(ImGui::BeginTable("census", 4, tableFlags)) {
+    ImGui::TableSetupColumn("Type");
+    ImGui::TableSetupColumn("Created by");
+    ImGui::TableSetupColumn("Count");
+    ImGui::TableSetupColumn("Bytes");
+    ImGui::TableHeadersRow();
+    for(const Resource::CensusRow &row : census) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(row.type.c_str());
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(row.creator ? row.creator : "(internal)");
+      ImGui::TableNextColumn();
+      ImGui::Text("%zu", row.count);
+      ImGui::TableNextColumn();
+      ImGui::Text("%zu", row.bytes);
+    }
+    ImGui::EndTable();
+  }
+
+  std::vector<float> created, collected, gcFrames;
+  for(unsigned int ago {}; const auto *sample {Resource::churn(ago)}; ++ago) {
+    created.push_back(sample->created);
+    collected.push_back(sample->collected);
+    gcFrames.push_back(sample->gcFrames);
+  }
+  const auto plot {[](const char *label, std::vector<float> &values) {
+    std::reverse(values.begin(), values.end()); // oldest tick first
+    ImGui::PlotHistogram(label, values.data(),
+      static_cast<int>(values.size()));
+  }};
+  plot("Created per tick", created);
+  plot("Collected per tick", collected);
+  plot("Consecutive GC ticks", gcFrames);
+
+  ImGui::TreePop();
+}
+
+static void showCacheMetrics(Context *ctx)
+{
+  const Context::SubresourceStats &stats {ctx->subresourceStats()};
+  if(!ImGui::TreeNode("Cache", "Cache (%zu copies, %zu bytes)",
+      stats.count, stats.bytes))
+    return;
+
+  ImGui::Text("TTL: %d frames", ctx->subresourceTTL());
+  if(const size_t budget {ctx->subresourceBudget()})
+    ImGui::Text("Budget: %zu bytes", budget);
+  else
+    ImGui::TextUnformatted("Budget: unlimited");
+  ImGui::Text("Hits: %u, installs: %u, evictions: %u",
+    stats.hits, stats.installs, stats.evictions);
+
+  ImGui::TreePop();
+}
+
+static void showFrameMetrics(Context *ctx)
+{
+  std::array<Context::PhaseStats, Context::FramePhaseCount> stats;
+  const unsigned int frames {ctx->frameStats(&stats)};
+  if(!ImGui::TreeNode("Frame phases", "Frame phases (%u frames)", frames))
+    return;
+
+  constexpr ImGuiTableFlags tableFlags {ImGuiTableFlags_Borders |
+    ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit};
+  if(ImGui::BeginTable("phases", 4, tableFlags)) {
+    ImGui::TableSetupColumn("Phase");
+    ImGui::TableSetupColumn("Min (ms)");
+    ImGui::TableSetupColumn("Avg (ms)");
+    ImGui::TableSetupColumn("P99 (ms)");
+    ImGui::TableHeadersRow();
+    for(int phase {}; phase < Context::FramePhaseCount; ++phase) {
+      const Context::PhaseStats &row {stats[phase]};
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(
+        Context::framePhaseName(static_cast<Context::FramePhase>(phase)));
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", row.min * 1000);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", row.avg * 1000);
+      ImGui::TableNextColumn();
+      ImGui::Text("%.3f", row.p99 * 1000);
+    }
+    ImGui::EndTable();
+  }
+
+  ImGui::TreePop();
+}
+
+static void showReaImGuiMetrics(Context *ctx)
+{
+  // appends to the same window by title
+  if(ImGui::Begin("Dear ImGui Metrics/Debugger") &&
+      ImGui::CollapsingHeader("ReaImGui", ImGuiTreeNodeFlags_DefaultOpen)) {
+    const Context::RenderStats &render {ctx->renderStats()};
+    ImGui::Text("Viewport frames: %u rendered, %u skipped (unchanged)",
+      render.rendered, render.skipped);
+    ImGui::Text("Frames postponed (over budget): %u", render.deferred);
+    Context::LatencyStats latency;
+    if(const unsigned int samples {ctx->inputLatency(&latency)}) {
+      ImGui::Text("Input latency (%u samples): "
+        "p50 %.1f ms, p90 %.1f ms, p99 %.1f ms, max %.1f ms", samples,
+        latency.p50 * 1000, latency.p90 * 1000,
+        latency.p99 * 1000, latency.max * 1000);
+    }
+    const Arena::Stats &memory {ctx->memoryStats()};
+    ImGui::Text("Memory: %zu KB in %zu blocks, %zu KB reserved, "
+      "%zu allocations", memory.bytes / 1024, memory.blocks,
+      memory.reserved / 1024, memory.allocations);
+    Context::DrawListMemory drawLists {};
+    for(const ImGuiWindow *window : ctx->imgui()->Windows) {
+      const Context::DrawListMemory windowMemory
+        {Context::drawListMemory(window->DrawList)};
+      drawLists.bytes += windowMemory.bytes;
+      drawLists.reserved += windowMemory.reserved;
+    }
+    ImGui::Text("Draw lists: %zu KB used, %zu KB reserved, %zu KB trimmed",
+      drawLists.bytes / 1024, drawLists.reserved / 1024,
+      ctx->drawListBytesTrimmed() / 1024);
+    showFrameMetrics(ctx);
+    showResourceMetrics();
+    showCacheMetrics(ctx);
+  }
+  ImGui::End();
+}
+
 API_FUNC(0_1, void, ShowMetricsWindow, (Context*,ctx)
 (RWO<bool*>,p_open),
 R"(Create Metrics/Debugger window.
-Display Dear ImGui internals: windows, draw commands, various internal state, etc.)")
+Display Dear ImGui internals: windows, draw commands, various internal state, etc.
+Also displays ReaImGui's resource usage (see GetResourceCensus).)")
 {
   FRAME_GUARD;
 
-  if(nativeWindowBehavior("Dear ImGui Metrics/Debugger", p_open))
+  if(nativeWindowBehavior("Dear ImGui Metrics/Debugger", p_open)) {
     ImGui::ShowMetricsWindow();
+    showReaImGuiMetrics(ctx);
+  }
 }
 
 API_FUNC(0_7, void, ShowDebugLogWindow, (Context*,ctx)
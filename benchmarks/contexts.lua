@@ -0,0 +1,35 @@
+-- Measure the cost of creating and destroying short-lived contexts
+--
+-- Each defer cycle creates a batch of contexts and begins their only frame.
+-- Ending the frame and destroying the contexts happens between defer cycles,
+-- so that cost is estimated from how much longer the time between cycles gets
+-- compared to idle cycles measured beforehand.
+
+package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+  '?.lua;' .. reaper.ImGui_GetBuiltinPath() .. '/?.lua'
+local ImGui = require 'imgui' '0.10'
+local timing = require 'timing'
+
+local IDLE_CYCLES, CYCLES, PER_CYCLE = 60, 60, 8
+
+local creation, gaps = 0, 0
+
+timing.idle(IDLE_CYCLES, nil, function(idle)
+  timing.loop(0, CYCLES, function(measured, gap)
+    if gap then gaps = gaps + gap end
+    local startTime = reaper.time_precise()
+    for i = 1, PER_CYCLE do
+      local ctx = ImGui.CreateContext(('Benchmark %d'):format(i))
+      ImGui.GetFrameCount(ctx) -- begin the frame
+    end
+    creation = creation + (reaper.time_precise() - startTime)
+  end, function(gap)
+    gaps = gaps + gap
+    local contexts = CYCLES * PER_CYCLE
+    timing.print('%d contexts (%d per defer cycle)', contexts, PER_CYCLE)
+    timing.print('  creation + NewFrame: %s per context',
+      timing.ms(creation / contexts))
+    timing.print('  EndFrame + destruction (estimated): %s per context',
+      timing.ms(math.max(0, gaps - idle * CYCLES) / contexts))
+  end)
+end)
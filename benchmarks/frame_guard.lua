@@ -0,0 +1,42 @@
+-- Measure the per-call cost of the frame guard
+--
+-- Most API functions first make sure their context is valid and in a frame.
+-- This calls a trivial function many times per defer cycle: with the same
+-- context every call (the common case) and alternating between two contexts
+-- (every call switches the current context). The cost of calling an empty Lua
+-- function the same way is subtracted.
+
+package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+  '?.lua;' .. reaper.ImGui_GetBuiltinPath() .. '/?.lua'
+local ImGui = require 'imgui' '0.10'
+local timing = require 'timing'
+
+local WARMUP_CYCLES, CYCLES, CALLS = 10, 60, 10000
+
+local ctxA = ImGui.CreateContext('Frame guard benchmark A')
+local ctxB = ImGui.CreateContext('Frame guard benchmark B')
+local same, alternating = {}, {}
+local sameTotal, alternatingTotal = 0, 0
+
+for i = 1, CALLS do
+  same[i], alternating[i] = ctxA, i % 2 == 1 and ctxA or ctxB
+end
+
+timing.loop(WARMUP_CYCLES, CYCLES, function(measured)
+  -- begin the frame of both contexts outside of the measurements
+  ImGui.GetFrameCount(ctxA)
+  ImGui.GetFrameCount(ctxB)
+
+  local empty = timing.calls(timing.noop, same)
+  local s = timing.calls(ImGui.GetFrameCount, same) - empty
+  local a = timing.calls(ImGui.GetFrameCount, alternating) - empty
+  if measured then
+    sameTotal, alternatingTotal = sameTotal + s, alternatingTotal + a
+  end
+end, function()
+  local calls = CYCLES * CALLS
+  timing.print('%d calls per defer cycle', CALLS)
+  timing.print('  same context: %s per call', timing.ns(sameTotal / calls))
+  timing.print('  alternating contexts: %s per call',
+    timing.ns(alternatingTotal / calls))
+end)
@@ -0,0 +1,58 @@
+-- Measure the cost of garbage-collecting a burst of short-lived objects
+--
+-- 10000 images are kept alive (attached to a context) while bursts of 5000
+-- unattached images are created and left unused. They are collected between
+-- defer cycles a few cycles later, so the cost of that tick is estimated from
+-- the longest time between cycles compared to idle cycles. ToggleTrace records
+-- the exact duration of each tick ("Timer::tick") for a closer look.
+
+package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+  '?.lua;' .. reaper.ImGui_GetBuiltinPath() .. '/?.lua'
+local ImGui = require 'imgui' '0.10'
+local timing = require 'timing'
+
+local LIVE, BURST, IDLE_CYCLES, ROUNDS, ROUND_CYCLES = 10000, 5000, 60, 10, 8
+
+local ctx = ImGui.CreateContext('GC benchmark')
+local longest, collected = 0, 0
+
+for i = 1, LIVE do
+  ImGui.Attach(ctx, ImGui.CreateImageFromSize(1, 1))
+end
+
+local function keepAlive()
+  ImGui.GetFrameCount(ctx)
+end
+
+local function report(idle)
+  timing.print('%d live objects, %d collected per burst', LIVE, BURST)
+  timing.print('  collection (estimated): %s per burst',
+    timing.ms(math.max(0, longest / ROUNDS - idle)))
+  if collected < BURST * ROUNDS then
+    timing.print('  warning: only %d of %d objects were collected',
+      collected, BURST * ROUNDS)
+  end
+end
+
+local function round(index, idle)
+  if index > ROUNDS then return report(idle) end
+
+  for i = 1, BURST do
+    ImGui.CreateImageFromSize(1, 1)
+  end
+
+  local roundLongest = 0
+  timing.loop(0, ROUND_CYCLES, function(measured, gap)
+    keepAlive()
+    if gap then roundLongest = math.max(roundLongest, gap) end
+  end, function(gap)
+    longest = longest + math.max(roundLongest, gap)
+    for ago = 0, ROUND_CYCLES - 1 do
+      local rv, created, count = ImGui.GetResourceChurn(ago)
+      if rv then collected = collected + count end
+    end
+    round(index + 1, idle)
+  end)
+end
+
+timing.idle(IDLE_CYCLES, keepAlive, function(idle) round(1, idle) end)
@@ -0,0 +1,54 @@
+-- Measure the cost of drawing many distinct images in the same frame
+--
+-- Each image use looks up the context's copy of the image (its subresource),
+-- so this grows with the number of images used by the context if the lookup
+-- is not constant-time. Only the time spent in ImGui.Image is measured.
+
+package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+  '?.lua;' .. reaper.ImGui_GetBuiltinPath() .. '/?.lua'
+local ImGui = require 'imgui' '0.10'
+local timing = require 'timing'
+
+local COUNTS, WARMUP_FRAMES, FRAMES = { 100, 1000, 4000 }, 10, 60
+local SIZE = 4
+
+local ctx = ImGui.CreateContext('Image benchmark')
+local images, pixels = {}, reaper.new_array(SIZE * SIZE)
+
+pixels.clear(0xFF8000FF)
+for i = 1, COUNTS[#COUNTS] do
+  local image = ImGui.CreateImageFromSize(SIZE, SIZE)
+  ImGui.Image_SetPixels_Array(image, 0, 0, SIZE, SIZE, pixels)
+  ImGui.Attach(ctx, image)
+  images[i] = image
+end
+
+local function run(step)
+  local count = COUNTS[step]
+  if not count then return end
+
+  local total, frames = 0, 0
+  -- the first frames upload the textures
+  timing.loop(WARMUP_FRAMES, FRAMES, function(measured)
+    ImGui.SetNextWindowSize(ctx, 400, 400, ImGui.Cond_FirstUseEver)
+    local visible, open = ImGui.Begin(ctx, 'Image benchmark', true)
+    if visible then
+      local startTime = reaper.time_precise()
+      for i = 1, count do
+        if i % 64 ~= 1 then ImGui.SameLine(ctx, 0, 0) end
+        ImGui.Image(ctx, images[i], SIZE, SIZE)
+      end
+      if measured then
+        total, frames = total + (reaper.time_precise() - startTime), frames + 1
+      end
+      ImGui.End(ctx)
+    end
+    return open
+  end, function()
+    timing.print('%5d images: %s per frame, %s per image', count,
+      timing.ms(total / frames), timing.ns(total / (frames * count)))
+    run(step + 1)
+  end)
+end
+
+run(1)
@@ -0,0 +1,31 @@
+-- Measure the cost of beginning a frame in many long-lived contexts
+--
+-- 8 contexts are kept alive and each begins a new frame every defer cycle.
+-- Only the beginning of the frames (NewFrame) is measured.
+
+package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+  '?.lua;' .. reaper.ImGui_GetBuiltinPath() .. '/?.lua'
+local ImGui = require 'imgui' '0.10'
+local timing = require 'timing'
+
+local CONTEXTS, WARMUP_CYCLES, CYCLES = 8, 10, 60
+
+local contexts, total = {}, 0
+
+for i = 1, CONTEXTS do
+  contexts[i] = ImGui.CreateContext(('New frame benchmark %d'):format(i))
+end
+
+timing.loop(WARMUP_CYCLES, CYCLES, function(measured)
+  local startTime = reaper.time_precise()
+  for i, ctx in ipairs(contexts) do
+    ImGui.GetFrameCount(ctx) -- begin the frame
+  end
+  if measured then
+    total = total + (reaper.time_precise() - startTime)
+  end
+end, function()
+  timing.print('%d contexts', CONTEXTS)
+  timing.print('  NewFrame: %s per context, %s per defer cycle',
+    timing.ms(total / (CYCLES * CONTEXTS)), timing.ms(total / CYCLES))
+end)
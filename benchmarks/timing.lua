@@ -0,0 +1,72 @@
+-- Shared helpers of the benchmark scripts
+--
+-- Scripts load this module with:
+--   package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+--     '?.lua;' .. package.path
+--   local timing = require 'timing'
+
+local timing = {}
+
+function timing.noop() end
+
+function timing.ms(seconds)
+  return ('%.3f ms'):format(seconds * 1e3)
+end
+
+function timing.ns(seconds)
+  return ('%.1f ns'):format(seconds * 1e9)
+end
+
+function timing.print(format, ...)
+  reaper.ShowConsoleMsg(format:format(...) .. '\n')
+end
+
+-- Time spent calling func once with each value of args
+function timing.calls(func, args)
+  local startTime = reaper.time_precise()
+  for i = 1, #args do
+    func(args[i])
+  end
+  return reaper.time_precise() - startTime
+end
+
+-- Call step(measured, gap) once per defer cycle, starting immediately:
+-- 'warmup' cycles with measured = false then 'cycles' with measured = true.
+-- 'gap' is the time elapsed since the end of the previous step, spent in the
+-- host and in ReaImGui's timer (ending frames, collecting objects...).
+-- done(gap) is called at the start of the cycle following the last step, with
+-- the gap that followed it, unless a step returned false to stop early.
+function timing.loop(warmup, cycles, step, done)
+  local cycle, lastEnd = 0, nil
+
+  local function loop()
+    local gap = lastEnd and reaper.time_precise() - lastEnd
+    cycle = cycle + 1
+    if cycle > warmup + cycles then
+      return done(gap)
+    elseif step(cycle > warmup, gap) == false then
+      return
+    end
+
+    lastEnd = reaper.time_precise()
+    reaper.defer(loop)
+  end
+
+  loop()
+end
+
+-- Average gap between 'cycles' defer cycles doing nothing but step() (if any),
+-- given to done(idle). Work done between cycles is estimated by comparing
+-- their gaps to this.
+function timing.idle(cycles, step, done)
+  local total, count = 0, 0
+  timing.loop(0, cycles, function(measured, gap)
+    if step then step() end
+    if gap then total, count = total + gap, count + 1 end
+  end, function(gap)
+    total, count = total + gap, count + 1
+    done(total / count)
+  end)
+end
+
+return timing
@@ -0,0 +1,43 @@
+-- Measure the cost of validating the objects given to the API
+--
+-- Every function taking an object first checks that it is alive and of the
+-- expected type. This keeps 100, 1000 then 10000 images alive and calls a
+-- trivial image function on them in random order. The cost of calling an
+-- empty Lua function the same way is subtracted.
+
+package.path = debug.getinfo(1, 'S').source:match('^@(.*[/\\])') ..
+  '?.lua;' .. reaper.ImGui_GetBuiltinPath() .. '/?.lua'
+local ImGui = require 'imgui' '0.10'
+local timing = require 'timing'
+
+local COUNTS, WARMUP_CYCLES, CYCLES, CALLS = { 100, 1000, 10000 }, 10, 60, 10000
+
+local ctx = ImGui.CreateContext('Validation benchmark')
+local images, order = {}, {}
+
+local function run(step)
+  local count = COUNTS[step]
+  if not count then return end
+
+  for i = #images + 1, count do
+    images[i] = ImGui.CreateImageFromSize(1, 1)
+    ImGui.Attach(ctx, images[i]) -- keep the image alive
+  end
+  for i = 1, CALLS do
+    order[i] = images[math.random(count)]
+  end
+
+  local total = 0
+  timing.loop(WARMUP_CYCLES, CYCLES, function(measured)
+    ImGui.GetFrameCount(ctx) -- keep the context alive
+    local elapsed = timing.calls(ImGui.Image_GetSize, order) -
+                    timing.calls(timing.noop, order)
+    if measured then total = total + elapsed end
+  end, function()
+    timing.print('%5d live images: %s per call',
+      count, timing.ns(total / (CYCLES * CALLS)))
+    run(step + 1)
+  end)
+end
+
+run(1)
@@ -321,6 +321,24 @@ ErrorClearer::~ErrorClearer()
   --g_reentrant;
 }
 
+static const char *g_currentFunction;
+
+const char *API::currentFunction()
+{
+  return g_currentFunction;
+}
+
+CallScope::CallScope(const char *fnName)
+  : m_outer {g_currentFunction}
+{
+  g_currentFunction = fnName;
+}
+
+CallScope::~CallScope()
+{
+  g_currentFunction = m_outer;
+}
+
 const char *API::lastError() noexcept
 {
   return g_lastError.empty() ? nullptr : &g_lastError[1];
@@ -41,6 +41,17 @@ namespace API {
     ~ErrorClearer();
   };
 
+  // innermost API function being executed (without prefix) or nullptr
+  const char *currentFunction();
+  class CallScope {
+  public:
+    CallScope(const char *fnName);
+    ~CallScope();
+
+  private:
+    const char *m_outer;
+  };
+
   using LineNumber = unsigned short;
   struct StoreLineNumber { StoreLineNumber(LineNumber val); };
 
@@ -0,0 +1,131 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "arena.hpp"
+
+#include "context.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <imgui/imgui.h>
+#include <new>
+
+struct alignas(std::max_align_t) Arena::Header {
+  Arena *arena; // nullptr if not pooled
+  size_t size;
+};
+
+Arena *Arena::g_scope;
+
+size_t Arena::classIndex(const size_t size)
+{
+  return (std::max<size_t>(size, 1) + GRANULARITY - 1) / GRANULARITY - 1;
+}
+
+void Arena::install()
+{
+  ImGui::SetAllocatorFunctions(
+    [](const size_t size, void *) {
+      Arena *arena {g_scope};
+      if(!arena) {
+        if(Context *ctx {Context::current()})
+          arena = ctx->arena();
+      }
+      return allocate(arena, size);
+    },
+    [](void *ptr, void *) { deallocate(ptr); });
+}
+
+void *Arena::allocate(Arena *arena, const size_t size)
+{
+  Header *header;
+  if(arena)
+    header = arena->take(size);
+  else
+    header = static_cast<Header *>(std::malloc(sizeof(Header) + size));
+  if(!header)
+    return nullptr;
+
+  header->arena = arena;
+  header->size = size;
+  return header + 1;
+}
+
+void Arena::deallocate(void *ptr) noexcept
+{
+  if(!ptr)
+    return;
+
+  Header *header {static_cast<Header *>(ptr) - 1};
+  if(Arena *arena {header->arena})
+    arena->give(header);
+  else
+    std::free(header);
+}
+
+Arena::Arena()
+  : m_stats {}, m_released {}
+{
+}
+
+void Arena::release()
+{
+  m_released = true;
+  if(!m_stats.blocks)
+    delete this;
+}
+
+Arena::Header *Arena::take(const size_t size)
+{
+  Header *block;
+  if(size > MAX_BLOCK_SIZE) {
+    block = static_cast<Header *>(std::malloc(sizeof(Header) + size));
+    if(!block)
+      return nullptr;
+    m_stats.reserved += sizeof(Header) + size;
+  }
+  else {
+    const size_t index {classIndex(size)};
+    SizeClass &sizeClass {m_classes[index]};
+    const size_t reserved {sizeClass.reserved()};
+    block = static_cast<Header *>(sizeClass.allocate(
+      sizeof(Header) + (index + 1) * GRANULARITY, SLAB_SIZE));
+    m_stats.reserved += sizeClass.reserved() - reserved;
+  }
+
+  m_stats.bytes += size;
+  ++m_stats.blocks;
+  ++m_stats.allocations;
+  return block;
+}
+
+void Arena::give(Header *block) noexcept
+{
+  const size_t size {block->size};
+  m_stats.bytes -= size;
+  --m_stats.blocks;
+
+  if(size > MAX_BLOCK_SIZE) {
+    m_stats.reserved -= sizeof(Header) + size;
+    std::free(block);
+  }
+  else
+    m_classes[classIndex(size)].deallocate(block);
+
+  if(m_released && !m_stats.blocks)
+    delete this;
+}
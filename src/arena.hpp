@@ -0,0 +1,79 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_ARENA_HPP
+#define REAIMGUI_ARENA_HPP
+
+#include "slab.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+// Per-context pools for Dear ImGui's allocations. Blocks are attributed to the
+// arena of the context that was current when they were allocated and go back
+// to it when freed regardless of which context is current by then. Released
+// arenas are deleted once their last block is freed. Main thread only.
+class Arena {
+public:
+  struct Stats {
+    size_t bytes, blocks; // live, as requested by imgui
+    size_t reserved;      // slabs and large blocks
+    size_t allocations;   // cumulative
+  };
+
+  // routes ImGui::MemAlloc/MemFree (must be done before any allocation)
+  static void install();
+  static void *allocate(Arena *, size_t size); // nullptr = not pooled
+  static void deallocate(void *) noexcept;
+
+  // routes allocations made while the context isn't current yet
+  class Scope {
+  public:
+    Scope(Arena *arena) : m_prev {g_scope} { g_scope = arena; }
+    ~Scope() { g_scope = m_prev; }
+
+  private:
+    Arena *m_prev;
+  };
+
+  struct Releaser { void operator()(Arena *arena) { arena->release(); } };
+  using Ptr = std::unique_ptr<Arena, Releaser>;
+
+  static Ptr create() { return Ptr {new Arena}; }
+  const Stats &stats() const { return m_stats; }
+
+private:
+  struct Header;
+  static constexpr size_t GRANULARITY {alignof(std::max_align_t)},
+    CLASSES {32}, MAX_BLOCK_SIZE {GRANULARITY * CLASSES}, SLAB_SIZE {8 * 1024};
+
+  static Arena *g_scope;
+  static size_t classIndex(size_t size);
+
+  Arena();
+  ~Arena() = default;
+  void release();
+  Header *take(size_t size);
+  void give(Header *) noexcept;
+
+  std::array<SizeClass, CLASSES> m_classes;
+  Stats m_stats;
+  bool m_released;
+};
+
+#endif
@@ -40,14 +40,16 @@ Window *Platform::createWindow(ImGuiViewport *viewport, DockerHost *dockerHost)
   return new CocoaWindow {viewport, dockerHost};
 }
 
-void Platform::updateMonitors()
+void Platform::queryMonitors(ImVector<ImGuiPlatformMonitor> *monitors)
 {
-  // TODO
-  // if(!g_monitorsChanged)
-  //   return;
-
-  ImGuiPlatformIO &pio {ImGui::GetPlatformIO()};
-  pio.Monitors.resize(0); // recycle allocated memory (don't use clear here!)
+  static id s_observer;
+  if(!s_observer) {
+    s_observer = [[NSNotificationCenter defaultCenter]
+      addObserverForName:NSApplicationDidChangeScreenParametersNotification
+                  object:nil
+                   queue:nil
+              usingBlock:^(NSNotification *) { Platform::invalidateMonitors(); }];
+  }
 
   NSArray<NSScreen *> *screens {[NSScreen screens]};
   const CGFloat mainHeight {screens[0].frame.size.height};
@@ -65,7 +67,7 @@ void Platform::updateMonitors()
     monitor.WorkSize.y = workFrame.size.height;
     monitor.DpiScale   = [screen backingScaleFactor];
 
-    pio.Monitors.push_back(monitor);
+    monitors->push_back(monitor);
   }
 }
 
@@ -152,7 +152,7 @@ void CocoaWindow::update()
   if(m_previousScale != m_viewport->DpiScale) {
     // resize macOS's GL objects when DPI changes (eg. moving to another screen)
     // NSViewFrameDidChangeNotification or WM_SIZE aren't sent
-    m_renderer->setSize(m_viewport->Size);
+    m_renderer->setWindowSize(m_viewport->Size);
     m_previousScale = m_viewport->DpiScale;
   }
 
@@ -22,14 +22,19 @@
 #include "docker.hpp"
 #include "error.hpp"
 #include "font.hpp"
+#include "font_atlas.hpp"
 #include "keymap.hpp"
 #include "platform.hpp"
+#include "profiler.hpp"
 #include "renderer.hpp"
 #include "settings.hpp"
+#include "trace.hpp"
 #include "viewport.hpp"
 #include "window.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
 #include <imgui/imgui_internal.h>
 #include <reaper_plugin_functions.h>
 #include <WDL/wdltypes.h>
@@ -48,11 +53,22 @@ enum StateFlags {
   RCE_Armed  = 1<<2,
   RCE_Active = 1<<3,
 #endif
+
+  RenderDeferred = 1<<4,
+  FrameFailed    = 1<<5,
+  Hibernating    = 1<<6,
 };
 
 constexpr ImGuiMouseButton DND_MouseButton {ImGuiMouseButton_Left};
+constexpr size_t MAX_ATTACHMENTS {0x10000};
+// Once this much time was spent rendering contexts during a timer tick,
+// background contexts are postponed to the next tick (at most once in a row)
+constexpr std::chrono::duration<float> RENDER_BUDGET_PER_TICK
+  {std::chrono::milliseconds {10}};
 constexpr ImGuiConfigFlags PRIVATE_CONFIG_FLAGS
   {ImGuiConfigFlags_ViewportsEnable};
+// smaller draw list buffers are never shrunk
+constexpr size_t MIN_TRIM_BYTES {64 * 1024};
 
 class TempCurrent {
 public:
@@ -71,22 +87,37 @@ struct Subresource {
 
   bool isResourceValid() const {
     return Resource::isValid(resource) && uniqId == resource->uniqId(); }
-  bool operator==(Resource *other) const {
-    return resource == other && uniqId == other->uniqId(); }
-  bool operator==(void *other) const { return data == other; }
 
   SubresourceData data;
   Resource *resource;
   unsigned int uniqId; // resource->uniqId() to detect pointer reuse
-  unsigned char unusedFrames;
+  unsigned short unusedFrames;
 };
 
-static std::string generateIniFilename(const ImGuiID id)
+unsigned int Context::g_frameEpoch;
+static size_t g_renderTick;
+static std::chrono::duration<float> g_renderTime; // spent during g_renderTick
+
+static const std::string &iniDirectory()
 {
-  std::string filename {GetResourcePath()};
+  static const std::string dir
+    {std::string {GetResourcePath()} + WDL_DIRCHAR_STR "ReaImGui"};
+  return dir;
+}
 
-  filename += WDL_DIRCHAR_STR "ReaImGui";
-  RecursiveCreateDirectory(filename.c_str(), 0);
+// created when settings are first saved instead of for every new context
+static void createIniDirectory()
+{
+  static bool created;
+  if(!created) {
+    RecursiveCreateDirectory(iniDirectory().c_str(), 0);
+    created = true;
+  }
+}
+
+static std::string generateIniFilename(const ImGuiID id)
+{
+  std::string filename {iniDirectory()};
 
   const size_t pathSize {filename.size()}, idSize {sizeof(id) * 2};
   filename.resize(pathSize + idSize + strlen(WDL_DIRCHAR_STR ".ini"));
@@ -96,6 +127,13 @@ static std::string generateIniFilename(const ImGuiID id)
   return filename;
 }
 
+static ImGuiContext *createImGuiContext(Arena *arena, ImFontAtlas *atlas)
+{
+  // the new context is not current yet, attribute its allocations explicitly
+  Arena::Scope scope {arena};
+  return ImGui::CreateContext(atlas);
+}
+
 Context *Context::current()
 {
   if(ImGuiContext *imgui {ImGui::GetCurrentContext()})
@@ -112,12 +150,23 @@ void Context::clearCurrent()
 Context::Context(const char *label, const int userConfigFlags)
   : m_id {ImHashStr(label)}, m_stateFlags {}, m_cursor {},
     m_lastFrame       {decltype(m_lastFrame)::clock::now()               },
+    m_subresourceStats {}, m_renderStats {}, m_texturesUpdated {},
+    m_subresourceBudget {},
+    m_subresourceTTL  {DEFAULT_SUBRESOURCE_TTL                           },
+    m_frameRateLimit {}, m_backgroundFrameRateLimit {}, m_renderCost {},
+    m_hibernationPeriod {},
+    m_monitorsGeneration {}, m_frameTimes {}, m_phaseTimes {}, m_framesTimed {},
+    m_inputLatencies {}, m_inputsPresented {}, m_drawListBytesTrimmed {},
     m_name            {label, ImGui::FindRenderedTextEnd(label)          },
     m_iniFilename     {generateIniFilename(m_id)                         },
-    m_imgui           {ImGui::CreateContext()                            },
+    m_arena           {Arena::create()                                   },
+    m_imgui           {createImGuiContext(m_arena.get(),
+      userConfigFlags & ReaImGuiConfigFlags_SharedFonts
+        ? FontAtlas::acquire() : nullptr)                                },
     m_dockers         {std::make_unique<DockerList>()                    },
     m_rendererFactory {std::make_unique<RendererFactory>()               },
-    m_font            {new SysFont {SysFont::SANS_SERIF}                 }
+    m_font            {hasSharedFonts() ? FontAtlas::defaultFont()
+                                    : new SysFont {SysFont::SANS_SERIF}  }
 {
   if(!*label) // does not prohibit empty window titles
     throw reascript_error {"context label is required"};
@@ -125,6 +174,7 @@ Context::Context(const char *label, const int userConfigFlags)
   static const std::string logFn
     {std::string {GetResourcePath()} + WDL_DIRCHAR_STR "imgui_log.txt"};
 
+  Trace::nameTrack(uniqId(), name());
   setCurrent();
 
   ImGuiIO &io {m_imgui->IO};
@@ -143,7 +193,6 @@ Context::Context(const char *label, const int userConfigFlags)
   io.ConfigNavCaptureKeyboard = Settings::NavCaptureKbd;
   io.ConfigNavCursorVisibleAlways = Settings::NavCurAlways;
   io.ConfigNavMoveSetMousePos = Settings::NavMoveMouse;
-  io.Fonts->Flags |= ImFontAtlasFlags_NoMouseCursors;
   io.LogFilename = logFn.c_str();
   io.UserData = this;
 
@@ -156,11 +205,7 @@ Context::Context(const char *label, const int userConfigFlags)
   io.ConfigErrorRecoveryEnableTooltip = false;
   io.ConfigErrorRecoveryEnableDebugLog = false;
 
-  setUserConfigFlags(userConfigFlags);
-  if(Settings::DockingEnable)
-    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-  if(Settings::NavEnable)
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+  initConfigFlags(userConfigFlags);
 
   Platform::install();
   Renderer::install();
@@ -169,7 +214,10 @@ Context::Context(const char *label, const int userConfigFlags)
   ImGuiStyle &style {m_imgui->Style};
   style.FontSizeBase = 12.f; // 9pt
   style.FramePadding.y = 2.f;
-  io.Fonts->SetFontLoader(Font::loader());
+  if(!hasSharedFonts()) { // the shared atlas is set up once
+    io.Fonts->Flags |= ImFontAtlasFlags_NoMouseCursors;
+    io.Fonts->SetFontLoader(Font::loader());
+  }
   io.FontDefault = m_font->instance(this);
 
   // prevent imgui from loading settings but not from saving them
@@ -178,12 +226,53 @@ Context::Context(const char *label, const int userConfigFlags)
     m_imgui->SettingsLoaded = true;
 
   screenset_registerNew(screensetKey().data(), &screensetProc, this);
+  m_font->pin();
 }
 
-Context::~Context()
+// Takes over the ImGui context, fonts, renderer factory and subresources
+// of a hibernating context. Everything else starts over as in a new context.
+Context::Context(Context *hibernated, const int userConfigFlags)
+  : m_id {hibernated->m_id}, m_stateFlags {}, m_cursor {},
+    m_lastFrame       {decltype(m_lastFrame)::clock::now()               },
+    m_subresources    {std::move(hibernated->m_subresources)             },
+    m_subresourceIndex {std::move(hibernated->m_subresourceIndex)        },
+    m_subresourceStats {}, m_renderStats {}, m_texturesUpdated {},
+    m_subresourceBudget {},
+    m_subresourceTTL  {DEFAULT_SUBRESOURCE_TTL                           },
+    m_frameRateLimit {}, m_backgroundFrameRateLimit {}, m_renderCost {},
+    m_hibernationPeriod {},
+    m_monitorsGeneration {}, m_frameTimes {}, m_phaseTimes {}, m_framesTimed {},
+    m_inputLatencies {}, m_inputsPresented {}, m_drawListBytesTrimmed {},
+    m_name            {std::move(hibernated->m_name)                     },
+    m_iniFilename     {std::move(hibernated->m_iniFilename)              },
+    m_arena           {std::move(hibernated->m_arena)                    },
+    m_imgui           {std::move(hibernated->m_imgui)                    },
+    m_dockers         {std::move(hibernated->m_dockers)                  },
+    m_rendererFactory {std::move(hibernated->m_rendererFactory)          },
+    m_font            {hibernated->m_font                                }
 {
+  hibernated->m_font = nullptr; // keeps its pin
+
+  Trace::nameTrack(uniqId(), name());
   setCurrent();
+
+  m_imgui->IO.UserData = this;
+  initConfigFlags(userConfigFlags);
+  if(hasSharedFonts())
+    FontAtlas::transfer(hibernated, this);
+  // hibernation destroyed the platform windows, including the main viewport's
+  Viewport::install();
+
+  screenset_registerNew(screensetKey().data(), &screensetProc, this);
+}
+
+Context::~Context()
+{
+  ++g_frameEpoch;
   screenset_unregisterByParam(this);
+  if(!m_imgui) // taken over by another context (see adopt)
+    return;
+  setCurrent();
 
   if(m_imgui->WithinFrameScope)
     endFrame(false);
@@ -194,16 +283,72 @@ Context::~Context()
   for(Subresource &sr : m_subresources)
     sr.data.uninstall(this);
 
+  if(hasSharedFonts())
+    FontAtlas::detach(this);
   for(ImTextureData *tex : m_imgui->UserTextures) {
     IM_ASSERT(tex->TexID == ImTextureID_Invalid); // renderer did clean up
     tex->Pixels = nullptr;
     delete tex;
   }
+
+  // pinned objects may have been destroyed first by Resource::destroyAll
+  for(Resource *obj : m_attachments) {
+    if(Resource::exists(obj))
+      obj->unpin();
+  }
+  if(Resource::exists(m_font))
+    m_font->unpin();
+}
+
+Context *Context::adopt(const char *label, const int userConfigFlags)
+{
+  const ImGuiID id {ImHashStr(label)};
+  const bool sharedFonts
+    {(userConfigFlags & ReaImGuiConfigFlags_SharedFonts) != 0};
+
+  Context *match {};
+  Resource::foreach<Context>([&](Context *ctx) {
+    if(!match && (ctx->m_stateFlags & Hibernating) && ctx->m_id == id &&
+        ctx->hasSharedFonts() == sharedFonts)
+      match = ctx;
+  });
+  if(!match)
+    return nullptr;
+
+  // under a new address so that the handle still held by the previous user
+  // of the context does not become valid again
+  Context *ctx {new Context {match, userConfigFlags}};
+  delete match;
+  return ctx;
+}
+
+void Context::hibernate()
+{
+  TempCurrent cur {this};
+
+  // windows are created again by the first frame after adoption
+  ImGui::DestroyPlatformWindows();
+
+  // attached objects belong to the script that stopped using the context
+  for(Resource *obj : m_attachments) {
+    if(Resource::exists(obj))
+      obj->unpin();
+  }
+  m_attachments = {};
+
+  m_stateFlags = Hibernating;
+  m_hibernatedAt = decltype(m_hibernatedAt)::clock::now();
 }
 
 void Context::ContextDeleter::operator()(ImGuiContext *imgui)
 {
+  const bool sharedFonts {imgui->IO.Fonts == FontAtlas::shared()};
+  // settings are saved on shutdown once they have been loaded
+  if(imgui->SettingsLoaded && imgui->IO.IniFilename)
+    createIniDirectory();
   ImGui::DestroyContext(imgui);
+  if(sharedFonts)
+    FontAtlas::release();
 }
 
 int Context::userConfigFlags() const
@@ -211,58 +356,125 @@ int Context::userConfigFlags() const
   return m_imgui->IO.ConfigFlags & ~PRIVATE_CONFIG_FLAGS;
 }
 
-void Context::setUserConfigFlags(const int userFlags)
+void Context::initConfigFlags(const int userConfigFlags)
+{
+  ImGuiIO &io {m_imgui->IO};
+  setUserConfigFlags(userConfigFlags);
+  if(Settings::DockingEnable)
+    io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
+  if(Settings::NavEnable)
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
+}
+
+void Context::setUserConfigFlags(int userFlags)
 {
+  // the font atlas is chosen once and for all when creating the context
+  if(hasSharedFonts())
+    userFlags |= ReaImGuiConfigFlags_SharedFonts;
+  else
+    userFlags &= ~ReaImGuiConfigFlags_SharedFonts;
+
   m_imgui->IO.ConfigFlags = userFlags | PRIVATE_CONFIG_FLAGS;
 }
 
+bool Context::hasSharedFonts() const
+{
+  return m_imgui->IO.Fonts == FontAtlas::shared();
+}
+
 void Context::attach(Resource *obj)
 {
-  if(m_attachments.size() >= 0x400)
+  if(m_attachments.size() >= MAX_ATTACHMENTS)
     throw reascript_error {"exceeded maximum object attachment limit"};
-  if(std::find(m_attachments.begin(), m_attachments.end(), obj)
-      != m_attachments.end())
+  if(m_attachments.contains(obj))
     throw reascript_error {"the object is already attached to this context"};
   else if(!obj->attachable(this))
     throw reascript_error {"the object cannot be attached to this context"};
 
-  m_attachments.push_back(obj);
+  m_attachments.insert(obj);
+  obj->pin();
 }
 
 void Context::detach(Resource *obj)
 {
-  const auto it {std::find(m_attachments.begin(), m_attachments.end(), obj)};
-  if(it == m_attachments.end())
+  if(!m_attachments.contains(obj))
     throw reascript_error {"the object is not attached to this context"};
 
-  m_attachments.erase(it);
+  m_attachments.erase(obj);
+  obj->unpin();
 }
 
 template<>
 void *Context::touch<void>(Resource *obj)
 {
-  auto it {std::find(m_subresources.begin(), m_subresources.end(), obj)};
-  if(it == m_subresources.end()) {
+  PROFILE_ZONE("Context::touch");
+
+  // indexed by uniqId rather than by address to not match an uninstalled
+  // subresource of a previous resource allocated at the same address
+  auto slot {m_subresourceIndex.find(obj->uniqId())};
+  if(slot == decltype(m_subresourceIndex)::NO_SLOT) {
+    slot = m_subresources.size();
     m_subresources.emplace_back(this, obj);
-    it = m_subresources.end() - 1;
+    m_subresourceIndex.insert(obj->uniqId(), slot);
+    ++m_subresourceStats.installs;
   }
-  else
-    it->unusedFrames = 0;
-  return it->data;
+  else {
+    m_subresources[slot].unusedFrames = 0;
+    ++m_subresourceStats.hits;
+  }
+  return m_subresources[slot].data;
+}
+
+void Context::setSubresourcePolicy(const unsigned short ttl,
+  const size_t budget)
+{
+  assert(ttl > 0 && ttl <= MAX_SUBRESOURCE_TTL);
+  m_subresourceTTL = ttl;
+  m_subresourceBudget = budget;
+}
+
+void Context::endDeferCycle()
+{
+  // present immediately instead of waiting for the next heartbeat
+  if(!(m_imgui->IO.ConfigFlags & ReaImGuiConfigFlags_LowLatency) ||
+      !m_imgui->WithinFrameScope)
+    return;
+
+  if(!endFrame(true))
+    m_stateFlags |= FrameFailed; // collected by the next heartbeat
+}
+
+bool Context::isValid() const
+{
+  // unusable as soon as a low-latency frame failed, not only once collected
+  return !(m_stateFlags & FrameFailed) && Resource::isValid();
 }
 
 bool Context::heartbeat()
 {
-  m_font->keepAlive();
-  for(Resource *obj : m_attachments)
-    obj->keepAlive();
+  Trace::Zone zone {"Heartbeat", uniqId()};
+  ++g_frameEpoch; // also invalidates the keep-alive done by the API
 
-  if(m_imgui->WithinFrameScope && !endFrame(true))
+  if(m_stateFlags & Hibernating) {
+    const std::chrono::duration<float> elapsed
+      {decltype(m_hibernatedAt)::clock::now() - m_hibernatedAt};
+    return elapsed.count() < m_hibernationPeriod;
+  }
+  else if(m_stateFlags & FrameFailed)
+    return false;
+  else if(m_imgui->WithinFrameScope && !endFrame(true))
     return false;
 
   // Keep the frame alive for at least one full timer cycle to prevent contexts
   // created within a defer callback from being immediately destroyed.
-  return Resource::heartbeat();
+  if(Resource::heartbeat())
+    return true;
+  else if(m_hibernationPeriod <= 0.f)
+    return false;
+
+  // invalid to the API (m_keepAlive < 0) until adopted
+  hibernate();
+  return true;
 }
 
 ImGuiIO &Context::IO()
@@ -282,19 +494,34 @@ void Context::setCurrent()
 
 bool Context::beginFrame() try
 {
+  m_phaseStart = decltype(m_phaseStart)::clock::now();
+  m_phaseTimes = {};
+
+  // keep measuring from the oldest input if the previous frame using input
+  // was not presented yet (postponed rendering)
+  if(!m_frameInputTime)
+    m_frameInputTime = m_inputTime;
+  m_inputTime.reset();
+
   touch<void>(m_font);
   assert(!m_imgui->WithinFrameScope);
 
-  Platform::updateMonitors(); // TODO only if changed
+  Platform::updateMonitors(&m_monitorsGeneration);
+  endPhase(Phase_UpdateMonitors);
 
   updateFrameInfo();
   updateMouseData();
   updateSettings();
+  endPhase(Phase_UpdateInputs);
 
+  if(hasSharedFonts())
+    FontAtlas::newFrame();
   ImGui::NewFrame();
+  endPhase(Phase_NewFrame);
 
   dragSources();
   m_dockers->drawAll();
+  endPhase(Phase_Dockers);
 
   return true;
 }
@@ -313,8 +540,33 @@ bool Context::enterFrame()
     return beginFrame();
 }
 
+void Context::setFrameRateLimit(const float foreground, const float background)
+{
+  m_frameRateLimit = foreground;
+  m_backgroundFrameRateLimit = background;
+}
+
+bool Context::isFrameDue()
+{
+  if(m_imgui->WithinFrameScope)
+    return true;
+
+  const float fps {isInForeground() ? m_frameRateLimit
+                                    : m_backgroundFrameRateLimit};
+  if(fps <= 0.f)
+    return true;
+
+  // tolerate some timer jitter to not skip every other frame when the limit
+  // is close to the rate of the defer loop
+  constexpr float JITTER_TOLERANCE {0.9f};
+  const auto now {decltype(m_lastFrame)::clock::now()};
+  const std::chrono::duration<float> elapsed {now - m_lastFrame};
+  return elapsed.count() * fps >= JITTER_TOLERANCE;
+}
+
 bool Context::endFrame(const bool render) try
 {
+  ++g_frameEpoch;
   setCurrent();
 
   if(!render) {
@@ -322,13 +574,24 @@ bool Context::endFrame(const bool render) try
     return true;
   }
 
+  endPhase(Phase_Script);
   updateCursor();
   updateDragDrop();
-  updateSubresources();
-  ImGui::Render();
-  ImGui::UpdatePlatformWindows();
-  ImGui::RenderPlatformWindowsDefault();
-  cleanupTextures();
+
+  if(scheduleRender())
+    present();
+  else {
+    // input was already processed: only the presentation is postponed
+    ImGui::EndFrame();
+    endPhase(Phase_Render);
+    ImGui::UpdatePlatformWindows();
+    endPhase(Phase_UpdatePlatformWindows);
+    cleanupTextures();
+    trimDrawLists();
+    endPhase(Phase_CleanupTextures);
+  }
+
+  m_frameTimes[m_framesTimed++ % FRAME_STATS_HISTORY] = m_phaseTimes;
 
 #ifdef FOCUS_POLLING
   // WM_KILLFOCUS/WM_ACTIVATE+WA_INACTIVE are incomplete or missing in SWELL
@@ -352,6 +615,124 @@ catch(const backend_error &e) {
   return false;
 }
 
+void Context::present()
+{
+  const auto startTime {std::chrono::steady_clock::now()};
+
+  updateSubresources();
+  endPhase(Phase_UpdateSubresources);
+  ImGui::Render();
+  if(hasSharedFonts())
+    FontAtlas::render(this);
+  endPhase(Phase_Render);
+  ImGui::UpdatePlatformWindows();
+  endPhase(Phase_UpdatePlatformWindows);
+  // the first viewport to render performs the texture updates of all of them
+  m_texturesUpdated = PresentedFrame::hasTextureUpdates();
+  ImGui::RenderPlatformWindowsDefault();
+  endPhase(Phase_RenderPlatformWindows);
+  // no viewport was presented: the input had no visible effect
+  m_frameInputTime.reset();
+  cleanupTextures();
+  trimDrawLists();
+  endPhase(Phase_CleanupTextures);
+
+  const std::chrono::duration<float> cost
+    {std::chrono::steady_clock::now() - startTime};
+  m_renderCost += (cost.count() - m_renderCost) / 4.f;
+  g_renderTime += cost;
+}
+
+void Context::endPhase(const FramePhase phase)
+{
+  const auto now {decltype(m_phaseStart)::clock::now()};
+  const std::chrono::duration<float> elapsed {now - m_phaseStart};
+  m_phaseTimes[phase] += elapsed.count();
+  Trace::complete(framePhaseName(phase), uniqId(), m_phaseStart, now);
+  m_phaseStart = now;
+}
+
+const char *Context::framePhaseName(const FramePhase phase)
+{
+  constexpr const char *names[] {
+    "UpdateMonitors", "UpdateInputs", "NewFrame", "Dockers", "Script",
+    "UpdateSubresources", "Render", "UpdatePlatformWindows",
+    "RenderPlatformWindows", "CleanupTextures",
+  };
+  static_assert(std::size(names) == FramePhaseCount);
+  return names[phase];
+}
+
+unsigned int Context::frameStats
+  (std::array<PhaseStats, FramePhaseCount> *stats) const
+{
+  const unsigned int frames
+    {std::min<unsigned int>(m_framesTimed, FRAME_STATS_HISTORY)};
+  std::array<float, FRAME_STATS_HISTORY> samples;
+
+  for(int phase {}; phase < FramePhaseCount; ++phase) {
+    PhaseStats &out {(*stats)[phase]};
+    if(!frames) {
+      out = {};
+      continue;
+    }
+
+    float sum {};
+    for(unsigned int i {}; i < frames; ++i)
+      sum += samples[i] = m_frameTimes[i][phase];
+    const auto end {samples.begin() + frames};
+    out.avg = sum / frames;
+    out.min = *std::min_element(samples.begin(), end);
+    // nearest-rank percentile
+    const auto p99 {samples.begin() + (frames * 99 + 99) / 100 - 1};
+    std::nth_element(samples.begin(), p99, end);
+    out.p99 = *p99;
+  }
+
+  return frames;
+}
+
+unsigned int Context::inputLatency(LatencyStats *stats) const
+{
+  const unsigned int count
+    {std::min<unsigned int>(m_inputsPresented, INPUT_LATENCY_HISTORY)};
+  if(!count) {
+    *stats = {};
+    return 0;
+  }
+
+  std::array<float, INPUT_LATENCY_HISTORY> samples;
+  const auto end {std::copy_n(m_inputLatencies.begin(), count, samples.begin())};
+  std::sort(samples.begin(), end);
+  const auto percentile {[&](const unsigned int p) { // nearest-rank
+    return samples[(count * p + 99) / 100 - 1];
+  }};
+  *stats = {percentile(50), percentile(90), percentile(99), *(end - 1)};
+
+  return count;
+}
+
+bool Context::scheduleRender()
+{
+  if(g_renderTick != Resource::tickCount()) {
+    g_renderTick = Resource::tickCount();
+    g_renderTime = {};
+  }
+
+  // the focused or hovered context is never postponed
+  const std::chrono::duration<float> expected {m_renderCost};
+  if((m_stateFlags & RenderDeferred) ||
+      (m_imgui->IO.ConfigFlags & ReaImGuiConfigFlags_LowLatency) ||
+      g_renderTime + expected <= RENDER_BUDGET_PER_TICK || isInForeground()) {
+    m_stateFlags &= ~RenderDeferred;
+    return true;
+  }
+
+  m_stateFlags |= RenderDeferred;
+  ++m_renderStats.deferred;
+  return false;
+}
+
 void Context::updateFrameInfo()
 {
   ImGuiIO &io {m_imgui->IO};
@@ -422,8 +803,28 @@ void Context::updateMouseData()
   io.AddMousePosEvent(pos.x, pos.y);
 }
 
+void Context::inputReceived()
+{
+  if(!m_inputTime)
+    m_inputTime = decltype(m_inputTime)::value_type::clock::now();
+}
+
+void Context::framePresented()
+{
+  if(!m_frameInputTime)
+    return;
+
+  const std::chrono::duration<float> latency
+    {decltype(m_frameInputTime)::value_type::clock::now() - *m_frameInputTime};
+  m_inputLatencies[m_inputsPresented++ % INPUT_LATENCY_HISTORY] =
+    latency.count();
+  m_frameInputTime.reset();
+}
+
 void Context::mouseInput(int button, const bool down)
 {
+  inputReceived();
+
 #ifdef __APPLE__
   if(button == ImGuiMouseButton_Left &&
       m_stateFlags & (down ? RCE_Armed : RCE_Active)) {
@@ -455,6 +856,7 @@ void Context::mouseWheel(const bool horizontal, float delta)
   };
 #endif
 
+  inputReceived();
   delta /= WHEEL_DELTA;
 
   if(horizontal)
@@ -465,6 +867,8 @@ void Context::mouseWheel(const bool horizontal, float delta)
 
 void Context::keyInput(ImGuiKey key, const bool down)
 {
+  inputReceived();
+
 #ifdef __APPLE__
   // Preferences > Editing Behavior > Mouse >
   // Control+left-click emulates right-click
@@ -497,11 +901,13 @@ void Context::charInput(const unsigned int codepoint)
       (codepoint >= 0xf700 && codepoint <= 0xf7ff)) // unicode private range
     return;
 
+  inputReceived();
   m_imgui->IO.AddInputCharacter(codepoint);
 }
 
 void Context::charInputUTF16(const ImWchar16 unit)
 {
+  inputReceived();
   m_imgui->IO.AddInputCharacterUTF16(unit);
 }
 
@@ -510,8 +916,12 @@ void Context::updateSettings()
   ImGuiIO &io {m_imgui->IO};
   if(io.ConfigFlags & ReaImGuiConfigFlags_NoSavedSettings)
     io.IniFilename = nullptr;
-  else
+  else {
     io.IniFilename = m_iniFilename.c_str();
+    // NewFrame saves the settings when the timer runs out
+    if(m_imgui->SettingsDirtyTimer > 0.f)
+      createIniDirectory();
+  }
 }
 
 void Context::updateDragDrop()
@@ -605,17 +1015,63 @@ void Context::endDrag(const bool drop)
 
 void Context::updateSubresources()
 {
-  for(auto it = m_subresources.begin(); it != m_subresources.end();) {
-    if(it->isResourceValid() && ++it->unusedFrames <= SUBRESOURCE_TTL) {
-      if(it->unusedFrames == 1)
-        it->resource->update(this, it->data);
-      ++it;
+  size_t bytes {};
+  for(size_t i {}; i < m_subresources.size();) {
+    Subresource &sr {m_subresources[i]};
+    if(!sr.isResourceValid())
+      evictSubresource(i);
+    else if(++sr.unusedFrames > m_subresourceTTL) {
+      evictSubresource(i);
+      ++m_subresourceStats.evictions;
     }
     else {
-      it->data.uninstall(this);
-      it = m_subresources.erase(it);
+      if(sr.unusedFrames == 1)
+        sr.resource->update(this, sr.data);
+      bytes += sr.data.size();
+      ++i;
     }
   }
+
+  if(m_subresourceBudget && bytes > m_subresourceBudget)
+    bytes = trimSubresources(bytes);
+
+  m_subresourceStats.count = m_subresources.size();
+  m_subresourceStats.bytes = bytes;
+}
+
+size_t Context::trimSubresources(size_t bytes)
+{
+  // least recently used first, sparing those used in the frame being rendered
+  std::vector<std::pair<unsigned short, unsigned int>> lru; // age, uniqId
+  for(const Subresource &sr : m_subresources) {
+    if(sr.unusedFrames > 1)
+      lru.emplace_back(sr.unusedFrames, sr.uniqId);
+  }
+  std::sort(lru.begin(), lru.end(), std::greater<>{});
+
+  for(const auto &[age, uniqId] : lru) {
+    if(bytes <= m_subresourceBudget)
+      break;
+    const auto slot {m_subresourceIndex.find(uniqId)};
+    bytes -= m_subresources[slot].data.size();
+    evictSubresource(slot);
+    ++m_subresourceStats.evictions;
+  }
+
+  return bytes;
+}
+
+void Context::evictSubresource(const size_t index)
+{
+  // swap the last subresource into the evicted one's slot
+  Subresource &sr {m_subresources[index]};
+  sr.data.uninstall(this);
+  m_subresourceIndex.erase(sr.uniqId);
+  if(&sr != &m_subresources.back()) {
+    sr = std::move(m_subresources.back());
+    m_subresourceIndex.assign(sr.uniqId, index);
+  }
+  m_subresources.pop_back();
 }
 
 ImTextureData *Context::createTexture()
@@ -641,6 +1097,113 @@ void Context::cleanupTextures()
   }
 }
 
+template<typename T>
+static size_t capacityBytes(const ImVector<T> &vec)
+{
+  return vec.Capacity * sizeof(T);
+}
+
+static size_t channelBytes(const ImDrawListSplitter &splitter)
+{
+  // channel 0 aliases the draw list's own buffers and the contents of the
+  // others have been merged into them
+  size_t bytes {};
+  const ImVector<ImDrawChannel> &channels {splitter._Channels};
+  for(int i {1}; i < channels.Size; ++i) {
+    bytes += capacityBytes(channels[i]._CmdBuffer) +
+             capacityBytes(channels[i]._IdxBuffer);
+  }
+  return bytes;
+}
+
+template<typename T>
+static size_t shrink(ImVector<T> &vec, const int peak)
+{
+  if(capacityBytes(vec) < MIN_TRIM_BYTES || vec.Capacity < peak * 4)
+    return 0;
+
+  // keep headroom for the usual frame-to-frame variations
+  ImVector<T> copy;
+  copy.reserve(std::max(vec.Size, peak + (peak / 2)));
+  copy.resize(vec.Size);
+  if(vec.Size)
+    memcpy(copy.Data, vec.Data, vec.size_in_bytes());
+
+  const size_t freed {capacityBytes(vec) - capacityBytes(copy)};
+  vec.swap(copy);
+  return freed;
+}
+
+template<typename Fn>
+static void forEachDrawnList(ImGuiContext *ctx, Fn &&fn)
+{
+  for(ImGuiWindow *window : ctx->Windows) {
+    if(window->Active)
+      fn(window->DrawList);
+  }
+
+  // background and foreground draw lists
+  for(ImGuiViewportP *viewport : ctx->Viewports) {
+    for(size_t i {}; i < std::size(viewport->BgFgDrawLists); ++i) {
+      if(viewport->BgFgDrawListsLastFrame[i] == ctx->FrameCount)
+        fn(viewport->BgFgDrawLists[i]);
+    }
+  }
+}
+
+Context::DrawListMemory Context::drawListMemory(const ImDrawList *drawList)
+{
+  return {
+    drawList->CmdBuffer.size_in_bytes() + drawList->IdxBuffer.size_in_bytes() +
+      drawList->VtxBuffer.size_in_bytes(),
+    capacityBytes(drawList->CmdBuffer) + capacityBytes(drawList->IdxBuffer) +
+      capacityBytes(drawList->VtxBuffer) + channelBytes(drawList->_Splitter),
+  };
+}
+
+// Dear ImGui only releases the buffers of windows unused for a while
+// (io.ConfigMemoryCompactTimer). Also shrink those that are still drawn
+// but much smaller than their largest size since the last trim.
+void Context::trimDrawLists()
+{
+  forEachDrawnList(m_imgui.get(), [this](const ImDrawList *drawList) {
+    unsigned int slot {m_drawListPeakIndex.find(drawList)};
+    if(slot == HashIndex<const ImDrawList *>::NO_SLOT) {
+      slot = m_drawListPeaks.size();
+      m_drawListPeakIndex.insert(drawList, slot);
+      m_drawListPeaks.push_back({});
+    }
+
+    DrawListPeak &peak {m_drawListPeaks[slot]};
+    peak.cmd = std::max(peak.cmd, drawList->CmdBuffer.Size);
+    peak.idx = std::max(peak.idx, drawList->IdxBuffer.Size);
+    peak.vtx = std::max(peak.vtx, drawList->VtxBuffer.Size);
+  });
+
+  if(m_imgui->FrameCount % DRAW_LIST_TRIM_PERIOD)
+    return;
+
+  // the same draw lists were all recorded above
+  forEachDrawnList(m_imgui.get(), [this](ImDrawList *drawList) {
+    const DrawListPeak &peak
+      {m_drawListPeaks[m_drawListPeakIndex.find(drawList)]};
+    m_drawListBytesTrimmed += shrink(drawList->CmdBuffer, peak.cmd) +
+                              shrink(drawList->IdxBuffer, peak.idx) +
+                              shrink(drawList->VtxBuffer, peak.vtx);
+
+    // channels are only allocated while splitting (eg. for legacy columns)
+    ImDrawListSplitter &splitter {drawList->_Splitter};
+    const size_t channels {channelBytes(splitter)};
+    if(splitter._Count <= 1 && channels >= MIN_TRIM_BYTES) {
+      splitter.ClearFreeMemory();
+      m_drawListBytesTrimmed += channels;
+    }
+  });
+
+  m_drawListPeaks.clear();
+  m_drawListPeakIndex.clear();
+}
+
 ImGuiViewport *Context::viewportUnder(const ImVec2 nativePos) const
 {
   HWND target {Platform::windowFromPoint(nativePos)};
@@ -671,6 +1234,33 @@ ImGuiViewport *Context::focusedViewport() const
   return nullptr;
 }
 
+bool Context::isVisible() const
+{
+  // the windows are not created until the first frame is rendered
+  if(!m_renderStats.rendered && !m_renderStats.skipped)
+    return true;
+
+  const ImGuiPlatformIO &pio {m_imgui->PlatformIO};
+  for(int i {1}; i < pio.Viewports.Size; ++i) { // skip the main viewport
+    ImGuiViewport *viewport {pio.Viewports[i]};
+    Viewport *instance {static_cast<Viewport *>(viewport->PlatformUserData)};
+
+    if(instance && !instance->isMinimized())
+      return true;
+  }
+
+  return false;
+}
+
+bool Context::isInForeground()
+{
+  if(focusedViewport())
+    return true;
+
+  TempCurrent cur {this};
+  return viewportUnder(Platform::getCursorPos());
+}
+
 void Context::updateFocus()
 {
   // Don't clear focus before any windows have been opened
@@ -722,6 +1312,9 @@ void Context::clearFocus()
 
 void Context::enableViewports(const bool enable)
 {
+  if(m_stateFlags & Hibernating) // windows were destroyed
+    return;
+
   const ImGuiPlatformIO &pio {m_imgui->PlatformIO};
   for(int i {1}; i < pio.Viewports.Size; ++i) { // skip the main viewport
     ImGuiViewport *viewport {pio.Viewports[i]};
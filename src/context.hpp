@@ -18,10 +18,14 @@
 #ifndef REAIMGUI_CONTEXT_HPP
 #define REAIMGUI_CONTEXT_HPP
 
+#include "arena.hpp"
+#include "hash_index.hpp"
 #include "resource.hpp"
 
+#include <array>
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -40,19 +44,58 @@ struct Subresource;
 
 enum ConfigFlags {
   ReaImGuiConfigFlags_NoSavedSettings = 1<<20,
+  ReaImGuiConfigFlags_LowLatency      = 1<<21,
+  ReaImGuiConfigFlags_SharedFonts     = 1<<22,
 };
 
 constexpr const char *REAIMGUI_PAYLOAD_TYPE_FILES {"_FILES"};
 
 class Context final : public Resource {
 public:
-  static constexpr unsigned char SUBRESOURCE_TTL {120};
+  static constexpr unsigned short
+    DEFAULT_SUBRESOURCE_TTL {120}, MAX_SUBRESOURCE_TTL {0xFFFE},
+    FRAME_STATS_HISTORY {120}, INPUT_LATENCY_HISTORY {120},
+    DRAW_LIST_TRIM_PERIOD {600}; // frames
+
+  enum FramePhase {
+    Phase_UpdateMonitors, Phase_UpdateInputs, Phase_NewFrame, Phase_Dockers,
+    Phase_Script, // between the beginning and the end of the frame
+    Phase_UpdateSubresources, Phase_Render, Phase_UpdatePlatformWindows,
+    Phase_RenderPlatformWindows, Phase_CleanupTextures,
+    FramePhaseCount,
+  };
+
+  struct PhaseStats {
+    float min, avg, p99; // in seconds
+  };
+
+  struct LatencyStats {
+    float p50, p90, p99, max; // in seconds
+  };
+
+  struct SubresourceStats {
+    unsigned int hits, installs, evictions; // cumulative
+    size_t count, bytes;                    // as of the last frame
+  };
+
+  struct DrawListMemory {
+    size_t bytes, reserved; // commands, indices and vertices
+  };
+
+  struct RenderStats {
+    unsigned int rendered, skipped; // viewport frames
+    unsigned int deferred;          // context frames over the tick's budget
+  };
 
   static Context *current();
   static void clearCurrent();
+  // changes whenever a context is destroyed or a frame may have ended
+  static unsigned int frameEpoch() { return g_frameEpoch; }
 
   Context(const char *label, int userConfigFlags = ImGuiConfigFlags_None);
   ~Context();
+  // take over a hibernating context created with the same label, or nullptr
+  static Context *adopt(const char *label, int userConfigFlags);
 
   // public api
   int userConfigFlags() const;
@@ -62,13 +105,31 @@ public:
 
   template<typename T>
   T *touch(Resource *r) { return static_cast<T *>(touch<void>(r)); }
+  // evict subresources unused for ttl frames or least recently used ones
+  // when over budget (0 = unlimited)
+  void setSubresourcePolicy(unsigned short ttl, size_t budget);
+  unsigned short subresourceTTL() const { return m_subresourceTTL; }
+  size_t subresourceBudget() const { return m_subresourceBudget; }
+  const SubresourceStats &subresourceStats() const
+    { return m_subresourceStats; }
   ImTextureData *createTexture();
 
   // api helpers
   void setCurrent();
   bool enterFrame();
+  // frames per second, 0 for unlimited (background is used while no viewport
+  // has focus or is hovered)
+  void setFrameRateLimit(float foreground, float background);
+  bool isFrameDue();
+  // whether any viewport is shown (not minimized, in an inactive docker tab
+  // or of zero size)
+  bool isVisible() const;
+  // seconds to keep the context around for adoption once unused (0 = none)
+  void setHibernationPeriod(float seconds) { m_hibernationPeriod = seconds; }
 
   // for backends
+  void inputReceived();
+  void framePresented();
   void mouseInput(int button, bool down);
   void mouseWheel(bool horizontal, float delta);
   void keyInput(ImGuiKey key, bool down);
@@ -79,6 +140,7 @@ public:
   void endDrag(bool drop);
   void updateFocus();
   void enableViewports(bool enable);
+  void endDeferCycle();
   void invalidateViewportsPos();
 
   ImGuiIO &IO();
@@ -86,22 +148,47 @@ public:
   DockerList &dockers() { return *m_dockers; }
   HCURSOR cursor() const { return m_cursor; }
   ImGuiContext *imgui() const { return m_imgui.get(); }
+  Arena *arena() const { return m_arena.get(); }
+  const Arena::Stats &memoryStats() const { return m_arena->stats(); }
+  bool hasSharedFonts() const;
   RendererFactory *rendererFactory() const { return m_rendererFactory.get(); }
   std::string screensetKey() const;
   const char *name() const { return m_name.c_str(); }
   const auto &draggedFiles() const { return m_draggedFiles; }
+  const RenderStats &renderStats() const { return m_renderStats; }
+  void countRenderedFrame(bool skipped)
+    { ++(skipped ? m_renderStats.skipped : m_renderStats.rendered); }
+  // whether textures were updated by the frame being presented
+  bool texturesUpdated() const { return m_texturesUpdated; }
+  static const char *framePhaseName(FramePhase);
+  static DrawListMemory drawListMemory(const ImDrawList *);
+  size_t drawListBytesTrimmed() const { return m_drawListBytesTrimmed; }
+  // over the last FRAME_STATS_HISTORY frames, returns the number of frames
+  unsigned int frameStats(std::array<PhaseStats, FramePhaseCount> *) const;
+  // time from input events to the presentation of the first frame using them
+  // over the last INPUT_LATENCY_HISTORY samples, returns the number of samples
+  unsigned int inputLatency(LatencyStats *) const;
 
   bool attachable(const Context *) const override { return false; }
 
 protected:
   bool heartbeat() override;
+  bool isValid() const override;
 
 private:
+  static unsigned int g_frameEpoch;
+
+  Context(Context *hibernated, int userConfigFlags); // see adopt
+
   static LRESULT screensetProc(const int action, const char *id,
     void *user, void *param, int paramSize);
 
+  void initConfigFlags(int userConfigFlags);
+  void hibernate();
   bool beginFrame();
   bool endFrame(bool render);
+  bool scheduleRender();
+  void present();
 
   void updateFrameInfo();
   void updateCursor();
@@ -109,10 +196,15 @@ private:
   void updateSettings();
   void updateDragDrop();
   void updateSubresources();
+  size_t trimSubresources(size_t bytes);
+  void evictSubresource(size_t index);
   void cleanupTextures();
+  void trimDrawLists();
+  void endPhase(FramePhase);
 
   ImGuiViewport *viewportUnder(ImVec2) const;
   ImGuiViewport *focusedViewport() const;
+  bool isInForeground();
   void dragSources();
   void clearFocus();
   bool isAnyKeyDown() const;
@@ -125,10 +217,38 @@ private:
   HCURSOR m_cursor;
   std::chrono::time_point<std::chrono::steady_clock> m_lastFrame; // monotonic
   std::vector<std::string> m_draggedFiles;
-  std::vector<Resource *> m_attachments;
+  HandleTable<Resource> m_attachments;
   std::vector<Subresource> m_subresources;
+  HashIndex<unsigned int> m_subresourceIndex; // by uniqId
+  SubresourceStats m_subresourceStats;
+  RenderStats m_renderStats;
+  bool m_texturesUpdated;
+  size_t m_subresourceBudget;
+  unsigned short m_subresourceTTL;
+  float m_frameRateLimit, m_backgroundFrameRateLimit;
+  float m_renderCost; // moving average in seconds
+  float m_hibernationPeriod;
+  std::chrono::time_point<std::chrono::steady_clock> m_hibernatedAt;
+  unsigned int m_monitorsGeneration;
+  using FrameTimes = std::array<float, FramePhaseCount>;
+  std::array<FrameTimes, FRAME_STATS_HISTORY> m_frameTimes; // ring buffer
+  FrameTimes m_phaseTimes; // of the current frame
+  unsigned int m_framesTimed;
+  std::chrono::time_point<std::chrono::steady_clock> m_phaseStart;
+  // oldest input not yet used by a frame and oldest input used by a frame
+  // that is not yet presented
+  std::optional<std::chrono::time_point<std::chrono::steady_clock>>
+    m_inputTime, m_frameInputTime;
+  std::array<float, INPUT_LATENCY_HISTORY> m_inputLatencies; // ring buffer
+  unsigned int m_inputsPresented;
+  // largest sizes of the draw lists drawn since the last trim
+  struct DrawListPeak { int cmd, idx, vtx; };
+  std::vector<DrawListPeak> m_drawListPeaks;
+  HashIndex<const ImDrawList *> m_drawListPeakIndex;
+  size_t m_drawListBytesTrimmed; // cumulative
   std::string m_name, m_iniFilename;
 
+  Arena::Ptr m_arena; // must outlive m_imgui
   struct ContextDeleter { void operator()(ImGuiContext *); };
   std::unique_ptr<ImGuiContext, ContextDeleter> m_imgui;
   std::unique_ptr<DockerList> m_dockers;
@@ -20,6 +20,7 @@
 #include "context.hpp"
 #include "error.hpp"
 #include "import.hpp"
+#include "trace.hpp"
 #include "window.hpp"
 
 #include <atlbase.h>
@@ -226,6 +227,7 @@ void D3D10Renderer::Shared::processTexture(ImTextureData *tex)
 
 void D3D10Renderer::Shared::createTexture(ImTextureData *tex)
 {
+  Trace::Zone zone {"Renderer::createTexture"};
   IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
 
   CComPtr<ID3D10Texture2D> texture;
@@ -262,6 +264,7 @@ void D3D10Renderer::Shared::createTexture(ImTextureData *tex)
 
 void D3D10Renderer::Shared::updateTexture(ImTextureData *tex)
 {
+  Trace::Zone zone {"Renderer::updateTexture"};
   auto texture {static_cast<ID3D10Texture2D *>(tex->BackendUserData)};
   for(const ImTextureRect &rect : tex->Updates) {
     D3D10_BOX box {
@@ -464,5 +467,8 @@ void D3D10Renderer::render(void *)
 
 void D3D10Renderer::swapBuffers(void *)
 {
-  m_swapChain->Present(0, 0); // present immediately (no vsync)
+  // present immediately (no vsync)
+  // occluded or lost device: present the next frame even if unchanged
+  if(m_swapChain->Present(0, 0) != S_OK)
+    invalidate();
 }
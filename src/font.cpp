@@ -19,6 +19,9 @@
 
 #include "context.hpp"
 #include "error.hpp"
+#include "font_atlas.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 
 #include <imgui/imgui_internal.h>
 #include <imgui/misc/freetype/imgui_freetype.h>
@@ -65,10 +68,22 @@ static void uninstall(Context *ctx, ImFont *font)
 
 SubresourceData Font::install(Context *ctx)
 {
-  if(ImFont *inst {m_src.install(ctx->IO().Fonts, this)}) {
+  if(ctx->hasSharedFonts())
+    return FontAtlas::install(this);
+
+  ImFont *inst {instantiate(ctx->IO().Fonts)};
+  size_t size {};
+  for(const ImFontConfig *src : inst->Sources)
+    size += src->FontDataSize;
+  return {inst, &uninstall, size};
+}
+
+ImFont *Font::instantiate(ImFontAtlas *atlas)
+{
+  if(ImFont *inst {m_src.install(atlas, this)}) {
     // don't set ImFontConfig::SizePixels to use EM square sizing
     inst->LegacySize = m_size;
-    return {inst, &uninstall};
+    return inst;
   }
 
   // imgui doesn't report what went wrong
@@ -78,14 +93,36 @@ SubresourceData Font::install(Context *ctx)
 SysFont::SysFont(const char *family, const int flags)
   : Font {}, m_family {family}, m_styles {flags}
 {
-  initPlatform();
+  // Resolving is slow (fontconfig reloads its configuration whenever no other
+  // SysFont is alive) and every context creates one for its default font.
+  // Successful matches are reused until REAPER is restarted.
+  struct Match { std::string family; int styles; FontSource src; };
+  static std::vector<Match> g_matches;
+
+  for(const Match &match : g_matches) {
+    if(match.styles == m_styles && match.family == m_family) {
+      m_src = match.src;
+      return;
+    }
+  }
 
-  if(auto src {resolve()})
+  initPlatform();
+  if(auto src {resolve()}) {
     m_src = *src;
+    g_matches.push_back({m_family, m_styles, *src});
+  }
   else
     throw reascript_error {"cannot find a matching system font"};
 }
 
+size_t SysFont::dataSize() const
+{
+  size_t size {Font::dataSize()};
+  for(const FontSource &fallback : m_fallbacks)
+    size += fallback.dataSize();
+  return size;
+}
+
 void SysFont::addFallback(ImFontAtlas *atlas, ImFont *inst, unsigned int codepoint)
 {
   // ImGui always requests a tab from ImFontAtlasBuildSetupFontBakedBlanks which
@@ -93,6 +130,7 @@ void SysFont::addFallback(ImFontAtlas *atlas, ImFont *inst, unsigned int codepoi
   if(codepoint == '\t')
     return;
 
+  PROFILE_ZONE("SysFont::addFallback");
   installMissingFallbacks(atlas, inst);
 
   // ImGui caches missing glyphs per baked size so, if none of the already added
@@ -104,6 +142,9 @@ void SysFont::addFallback(ImFontAtlas *atlas, ImFont *inst, unsigned int codepoi
   else
     m_resolved.insert(codepoint);
 
+  Trace::Zone zone {"SysFont::addFallback"};
+  if(!m_platform) // not initialized when matched from the cache
+    initPlatform();
   const auto src {resolve(codepoint)};
   if(src && *src != m_src) {
     m_fallbacks.push_back(*src);
@@ -147,3 +188,10 @@ bool FontSource::operator==(const FontSource &o) const
 {
   return m_data == o.m_data && m_index == o.m_index && m_styles == o.m_styles;
 }
+
+size_t FontSource::dataSize() const
+{
+  if(auto data {std::get_if<std::vector<unsigned char>>(&m_data)})
+    return data->capacity();
+  return 0;
+}
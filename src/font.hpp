@@ -44,6 +44,7 @@ struct FontSource {
 
   bool operator==(const FontSource &) const;
   bool operator!=(const FontSource &o) const { return !(*this == o); }
+  size_t dataSize() const; // 0 for files not loaded into memory
 
   std::variant<std::string, std::vector<unsigned char>> m_data;
   unsigned int m_index;
@@ -58,9 +59,11 @@ public:
   Font(std::vector<unsigned char> &&, unsigned int index, int style = 0);
 
   bool attachable(const Context *) const override { return true; }
+  size_t dataSize() const override { return m_src.dataSize(); }
   SubresourceData install(Context *) override;
 
   ImFont *instance(Context *ctx);
+  ImFont *instantiate(ImFontAtlas *);
 
   int legacySize() const { return m_size; }
   void setLegacySize(int sz) { m_size = sz; }
@@ -84,6 +87,7 @@ public:
     *SERIF      {"serif"};
 
   SysFont(const char *family, int style = 0);
+  size_t dataSize() const override;
   void addFallback(ImFontAtlas *, ImFont *, unsigned int codepoint);
 
 private:
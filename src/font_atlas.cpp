@@ -0,0 +1,336 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "font_atlas.hpp"
+
+#include "context.hpp"
+#include "font.hpp"
+
+#include <algorithm>
+#include <imgui/imgui_internal.h>
+#include <vector>
+
+struct SharedFont {
+  Font *font;
+  unsigned int uniqId, refs;
+  ImFont *inst;
+};
+
+struct SharedTexture {
+  struct Update {
+    ImTextureRect rect;
+    unsigned int version;
+    unsigned char age; // in timer ticks
+  };
+
+  ImTextureData *tex;
+  int uniqueId;
+  unsigned int version;
+  std::vector<Update> updates;
+};
+
+struct MirrorTexture {
+  Context *ctx;
+  ImTextureData *shared, *tex; // tex is owned by ctx
+  unsigned int version;
+};
+
+// shared textures only need a valid identifier, they never reach renderers
+constexpr ImTextureID MIRRORED_TEXTURE {0};
+
+static ImFontAtlas *g_atlas;
+static unsigned int g_users;
+static int g_atlasFrame;
+static size_t g_atlasTick;
+static SysFont *g_defaultFont;
+static unsigned int g_defaultFontId;
+static std::vector<SharedFont> g_fonts;
+static std::vector<SharedTexture> g_textures;
+static std::vector<MirrorTexture> g_mirrors;
+
+ImFontAtlas *FontAtlas::shared()
+{
+  return g_atlas;
+}
+
+ImFontAtlas *FontAtlas::acquire()
+{
+  if(!g_atlas) {
+    g_atlas = IM_NEW(ImFontAtlas)();
+    ++g_atlas->RefCount; // don't let the last ImGui context delete it
+    g_atlas->Flags |= ImFontAtlasFlags_NoMouseCursors;
+    g_atlas->SetFontLoader(Font::loader());
+    g_atlasTick = static_cast<size_t>(-1);
+  }
+
+  ++g_users;
+  return g_atlas;
+}
+
+void FontAtlas::release()
+{
+  assert(g_users > 0);
+  if(--g_users)
+    return;
+
+  // the contexts' mirror textures and font instances are gone by now
+  assert(g_mirrors.empty());
+  g_fonts.clear();
+  g_textures.clear();
+  --g_atlas->RefCount;
+  IM_DELETE(g_atlas);
+  g_atlas = nullptr;
+}
+
+SysFont *FontAtlas::defaultFont()
+{
+  // kept alive by the contexts pinning it as their default font
+  if(!Resource::exists(g_defaultFont) || g_defaultFont->uniqId() != g_defaultFontId) {
+    g_defaultFont = new SysFont {SysFont::SANS_SERIF};
+    g_defaultFontId = g_defaultFont->uniqId();
+  }
+
+  return g_defaultFont;
+}
+
+static void uninstall(Context *, ImFont *inst)
+{
+  const auto it {std::find_if(g_fonts.begin(), g_fonts.end(),
+    [inst](const SharedFont &font) { return font.inst == inst; })};
+  assert(it != g_fonts.end());
+  if(--it->refs)
+    return;
+
+  g_atlas->RemoveFont(inst);
+  g_fonts.erase(it);
+}
+
+SubresourceData FontAtlas::install(Font *font)
+{
+  auto it {std::find_if(g_fonts.begin(), g_fonts.end(),
+    [font](const SharedFont &shared) {
+      return shared.font == font && shared.uniqId == font->uniqId();
+    })};
+  if(it == g_fonts.end()) {
+    g_fonts.push_back({font, font->uniqId(), 0, font->instantiate(g_atlas)});
+    it = g_fonts.end() - 1;
+  }
+
+  ++it->refs;
+  // baked sizes are shared by every context using this instance
+  // (not reporting a size as evicting it from one context frees nothing)
+  return {it->inst, &uninstall};
+}
+
+void FontAtlas::newFrame()
+{
+  if(g_atlasTick == Resource::tickCount())
+    return;
+  g_atlasTick = Resource::tickCount();
+
+  ImFontAtlasUpdateNewFrame(g_atlas, ++g_atlasFrame, true);
+
+  // mirrors of contexts that did not render for this long get a full upload
+  constexpr unsigned char UPDATE_TTL {60};
+  for(SharedTexture &shared : g_textures) {
+    std::erase_if(shared.updates, [](SharedTexture::Update &update) {
+      return ++update.age >= UPDATE_TTL;
+    });
+  }
+}
+
+static void destroyMirror(const MirrorTexture &mirror)
+{
+  ImTextureData *tex {mirror.tex};
+  tex->Pixels = nullptr; // owned by the shared texture
+  if(tex->TexID == ImTextureID_Invalid) // never reached the renderer
+    tex->Status = ImTextureStatus_Destroyed;
+  else
+    tex->Status = ImTextureStatus_WantDestroy;
+}
+
+static void destroyMirrors(const ImTextureData *shared)
+{
+  std::erase_if(g_mirrors, [shared](const MirrorTexture &mirror) {
+    if(mirror.shared != shared)
+      return false;
+    destroyMirror(mirror);
+    return true;
+  });
+}
+
+// Acts as the renderer backend of the shared textures. Their contents are
+// uploaded by the contexts' renderers through mirror textures.
+static void syncTextures()
+{
+  const auto &texList {g_atlas->TexList};
+  std::erase_if(g_textures, [&texList](const SharedTexture &shared) {
+    const bool gone {!texList.contains(shared.tex) ||
+      shared.tex->UniqueID != shared.uniqueId ||
+      shared.tex->Status == ImTextureStatus_WantDestroy ||
+      shared.tex->Status == ImTextureStatus_Destroyed};
+    if(gone)
+      destroyMirrors(shared.tex);
+    return gone;
+  });
+
+  for(ImTextureData *tex : texList) {
+    if(tex->Status == ImTextureStatus_WantDestroy) {
+      tex->SetTexID(ImTextureID_Invalid);
+      tex->SetStatus(ImTextureStatus_Destroyed);
+      continue;
+    }
+    else if(tex->Status == ImTextureStatus_Destroyed)
+      continue;
+
+    auto it {std::find_if(g_textures.begin(), g_textures.end(),
+      [tex](const SharedTexture &shared) { return shared.tex == tex; })};
+    if(it == g_textures.end()) {
+      g_textures.push_back({tex, tex->UniqueID, 0, {}});
+      it = g_textures.end() - 1;
+    }
+
+    if(tex->Status == ImTextureStatus_WantCreate) {
+      // (re)created: mirrors must upload everything
+      ++it->version;
+      it->updates.clear();
+    }
+    else if(tex->Status == ImTextureStatus_WantUpdates) {
+      for(const ImTextureRect &rect : tex->Updates)
+        it->updates.push_back({rect, ++it->version, 0});
+      tex->Updates.resize(0);
+    }
+    tex->SetTexID(MIRRORED_TEXTURE);
+    tex->SetStatus(ImTextureStatus_OK);
+  }
+}
+
+static ImTextureData *createMirror(Context *ctx, const ImTextureData *shared)
+{
+  ImTextureData *tex {ctx->createTexture()};
+  tex->UniqueID = shared->UniqueID;
+  tex->Status = ImTextureStatus_WantCreate;
+  tex->Format = shared->Format;
+  tex->Width = shared->Width;
+  tex->Height = shared->Height;
+  tex->BytesPerPixel = shared->BytesPerPixel;
+  tex->Pixels = shared->Pixels;
+  tex->RefCount = 1;
+
+  // the texture list of the current frame was already built
+  ImGui::GetPlatformIO().Textures.push_back(tex);
+
+  return tex;
+}
+
+static void updateMirror(MirrorTexture &mirror, const SharedTexture &shared)
+{
+  ImTextureData *tex {mirror.tex};
+  tex->Pixels = shared.tex->Pixels;
+  if(mirror.version == shared.version)
+    return;
+
+  if(tex->Status == ImTextureStatus_OK ||
+      tex->Status == ImTextureStatus_WantUpdates) {
+    // versions are sequential: check whether the next one is still in history
+    if(shared.updates.empty() || shared.updates.front().version > mirror.version + 1) {
+      tex->Updates.push_back({0, 0, static_cast<unsigned short>(tex->Width),
+                                    static_cast<unsigned short>(tex->Height)});
+    }
+    else {
+      for(const SharedTexture::Update &update : shared.updates) {
+        if(update.version > mirror.version)
+          tex->Updates.push_back(update.rect);
+      }
+    }
+    tex->SetStatus(ImTextureStatus_WantUpdates);
+  }
+
+  mirror.version = shared.version;
+}
+
+void FontAtlas::render(Context *ctx)
+{
+  syncTextures();
+
+  // shared textures must not reach the renderers
+  ImGuiPlatformIO &pio {ImGui::GetPlatformIO()};
+  for(ImTextureData *tex : g_atlas->TexList)
+    pio.Textures.find_erase(tex);
+
+  static std::vector<MirrorTexture *> mirrors; // of this context
+  mirrors.clear();
+  for(const SharedTexture &shared : g_textures) {
+    auto it {std::find_if(g_mirrors.begin(), g_mirrors.end(),
+      [ctx, &shared](const MirrorTexture &mirror) {
+        return mirror.ctx == ctx && mirror.shared == shared.tex;
+      })};
+    if(it != g_mirrors.end() && (it->tex->Width != shared.tex->Width ||
+                                 it->tex->Height != shared.tex->Height)) {
+      destroyMirror(*it);
+      g_mirrors.erase(it);
+      it = g_mirrors.end();
+    }
+
+    if(it == g_mirrors.end())
+      g_mirrors.push_back({ctx, shared.tex, createMirror(ctx, shared.tex), shared.version});
+    else
+      updateMirror(*it, shared);
+  }
+  for(MirrorTexture &mirror : g_mirrors) {
+    if(mirror.ctx == ctx)
+      mirrors.push_back(&mirror);
+  }
+
+  // point the draw commands to this context's mirrors
+  for(const ImGuiViewport *viewport : pio.Viewports) {
+    if(!viewport->DrawData)
+      continue;
+    for(ImDrawList *drawList : viewport->DrawData->CmdLists) {
+      const ImTextureData *from {};
+      ImTextureData *to {};
+      for(ImDrawCmd &cmd : drawList->CmdBuffer) {
+        if(cmd.TexRef._TexData != from) {
+          from = cmd.TexRef._TexData, to = nullptr;
+          for(const MirrorTexture *mirror : mirrors) {
+            if(mirror->shared == from) {
+              to = mirror->tex;
+              break;
+            }
+          }
+        }
+        if(to)
+          cmd.TexRef._TexData = to;
+      }
+    }
+  }
+}
+
+void FontAtlas::detach(Context *ctx)
+{
+  // the context deletes its own textures
+  std::erase_if(g_mirrors,
+    [ctx](const MirrorTexture &mirror) { return mirror.ctx == ctx; });
+}
+
+void FontAtlas::transfer(const Context *from, Context *to)
+{
+  for(MirrorTexture &mirror : g_mirrors) {
+    if(mirror.ctx == from)
+      mirror.ctx = to;
+  }
+}
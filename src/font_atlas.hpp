@@ -0,0 +1,45 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_FONT_ATLAS_HPP
+#define REAIMGUI_FONT_ATLAS_HPP
+
+class Context;
+class Font;
+class SubresourceData;
+class SysFont;
+struct ImFontAtlas;
+
+// Process-wide font atlas optionally shared by contexts created with
+// ReaImGuiConfigFlags_SharedFonts. Glyphs are rasterized once for all of them.
+// Each context uploads the atlas textures through its own renderer (mirror
+// textures borrowing the shared pixels, like Bitmap does) as textures cannot
+// be shared between renderer factories.
+namespace FontAtlas {
+  ImFontAtlas *shared(); // nullptr when unused
+  ImFontAtlas *acquire();
+  void release(); // after destroying an ImGui context using the shared atlas
+  SysFont *defaultFont();
+
+  SubresourceData install(Font *); // reference counted per font
+  void newFrame(); // before ImGui::NewFrame, effective once per timer tick
+  void render(Context *); // after ImGui::Render
+  void detach(Context *);
+  void transfer(const Context *from, Context *to); // see Context::adopt
+};
+
+#endif
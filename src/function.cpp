@@ -19,6 +19,7 @@
 
 #include "api_eel.hpp"
 #include "error.hpp"
+#include "profiler.hpp"
 
 #include <reaper_plugin_functions.h>
 
@@ -88,6 +89,7 @@ void Function::VMDeleter::operator()(NSEEL_VMCTX vm)
 
 void Function::execute() noexcept
 {
+  PROFILE_ZONE("Function::execute");
   NSEEL_code_execute(m_program.get());
 }
 
@@ -19,6 +19,7 @@
 #define REAIMGUI_FUNCTION_HPP
 
 #include "resource.hpp"
+#include "slab.hpp"
 
 #include <memory>
 #include <optional>
@@ -30,7 +31,7 @@ using NSEEL_CODEHANDLE = void *;
 class eel_string_context_state;
 struct reaper_array;
 
-class Function : public Resource {
+class Function : public Resource, public Pooled {
 public:
   static void setup();
 
@@ -70,13 +70,23 @@ Window *Platform::createWindow(ImGuiViewport *viewport, DockerHost *dockerHost)
   return new GDKWindow {viewport, dockerHost};
 }
 
-void Platform::updateMonitors()
+static void monitorsChanged(GdkScreen *, gpointer)
 {
-  ImGuiPlatformIO &pio {ImGui::GetPlatformIO()};
-  pio.Monitors.resize(0); // recycle allocated memory (don't use clear here!)
+  Platform::invalidateMonitors();
+}
 
+void Platform::queryMonitors(ImVector<ImGuiPlatformMonitor> *monitors)
+{
   GdkDisplay *display {gdk_display_get_default()};
 
+  static bool s_watching;
+  if(!s_watching) {
+    GdkScreen *screen {gdk_display_get_default_screen(display)};
+    g_signal_connect(screen, "monitors-changed", G_CALLBACK(monitorsChanged), nullptr);
+    g_signal_connect(screen, "size-changed",     G_CALLBACK(monitorsChanged), nullptr);
+    s_watching = true;
+  }
+
   const int count {gdk_display_get_n_monitors(display)};
   for(int i {}; i < count; ++i) {
     GdkMonitor *monitor {gdk_display_get_monitor(display, i)};
@@ -102,9 +112,9 @@ void Platform::updateMonitors()
     scalePosition(&imguiMonitor.WorkSize);
 
     if(gdk_monitor_is_primary(monitor))
-      pio.Monitors.push_front(imguiMonitor);
+      monitors->push_front(imguiMonitor);
     else
-      pio.Monitors.push_back(imguiMonitor);
+      monitors->push_back(imguiMonitor);
   }
 }
 
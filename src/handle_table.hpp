@@ -0,0 +1,71 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_HANDLE_TABLE_HPP
+#define REAIMGUI_HANDLE_TABLE_HPP
+
+#include "hash_index.hpp"
+
+// Pointers stored in contiguous slots with a hash index on the side for
+// constant-time insertion, removal and lookup. Lookups never dereference the
+// given pointer, so it may be dangling or made up.
+// Removal moves the last slot into the freed one: order is not stable.
+// Caller is responsible for not inserting the same value more than once.
+template<typename T>
+class HandleTable {
+public:
+  using Slot = typename HashIndex<const T *>::Slot;
+
+  auto begin() const { return m_slots.begin(); }
+  auto end()   const { return m_slots.end();   }
+  T *operator[](const Slot i) const { return m_slots[i]; }
+  T *back() const { return m_slots.back(); }
+  size_t size() const { return m_slots.size();  }
+  bool empty()  const { return m_slots.empty(); }
+
+  Slot insert(T *v)
+  {
+    const Slot slot {static_cast<Slot>(m_slots.size())};
+    m_index.insert(v, slot);
+    m_slots.push_back(v);
+    return slot;
+  }
+
+  void erase(const T *v)
+  {
+    const Slot slot {m_index.find(v)};
+    assert(slot != HashIndex<const T *>::NO_SLOT);
+
+    if(T *last {m_slots.back()}; last != v) {
+      m_slots[slot] = last;
+      m_index.assign(last, slot);
+    }
+    m_slots.pop_back();
+    m_index.erase(v);
+  }
+
+  bool contains(const T *v) const
+  {
+    return v && m_index.find(v) != HashIndex<const T *>::NO_SLOT;
+  }
+
+private:
+  std::vector<T *> m_slots;
+  HashIndex<const T *> m_index;
+};
+
+#endif
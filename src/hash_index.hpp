@@ -0,0 +1,147 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_HASH_INDEX_HPP
+#define REAIMGUI_HASH_INDEX_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// open-addressing map of pointers (or other numbers) to positions in
+// a separately stored contiguous array
+// caller is responsible for not inserting the same key more than once
+template<typename Key>
+class HashIndex {
+public:
+  using Slot = unsigned int;
+  static constexpr Slot NO_SLOT {static_cast<Slot>(-1)};
+
+  size_t size() const { return m_size; }
+
+  Slot find(const Key key) const
+  {
+    if(m_buckets.empty())
+      return NO_SLOT;
+
+    for(size_t i {bucketFor(key)}; m_buckets[i].slot != NO_SLOT; i = next(i)) {
+      if(m_buckets[i].key == key)
+        return m_buckets[i].slot;
+    }
+
+    return NO_SLOT;
+  }
+
+  void insert(const Key key, const Slot slot)
+  {
+    if((m_size + 1) * 2 > m_buckets.size())
+      rehash(m_buckets.empty() ? MIN_BUCKETS : m_buckets.size() * 2);
+
+    place(key, slot);
+    ++m_size;
+  }
+
+  void assign(const Key key, const Slot slot)
+  {
+    const size_t i {findBucket(key)};
+    assert(i != NOT_FOUND);
+    m_buckets[i].slot = slot;
+  }
+
+  void erase(const Key key)
+  {
+    size_t i {findBucket(key)};
+    assert(i != NOT_FOUND);
+
+    // backward shift deletion: keep probe sequences free of holes
+    for(size_t j {next(i)}; m_buckets[j].slot != NO_SLOT; j = next(j)) {
+      const size_t home {bucketFor(m_buckets[j].key)};
+      if(((j - home) & mask()) >= ((j - i) & mask())) {
+        m_buckets[i] = m_buckets[j];
+        i = j;
+      }
+    }
+
+    m_buckets[i].slot = NO_SLOT;
+    --m_size;
+  }
+
+  void clear()
+  {
+    m_buckets.clear();
+    m_size = 0;
+  }
+
+private:
+  static constexpr size_t MIN_BUCKETS {64}, NOT_FOUND {static_cast<size_t>(-1)};
+
+  struct Bucket {
+    Key key;
+    Slot slot;
+  };
+
+  size_t mask() const { return m_buckets.size() - 1; }
+  size_t next(const size_t i) const { return (i + 1) & mask(); }
+
+  size_t bucketFor(const Key key) const
+  {
+    // Fibonacci hashing spreads the aligned low bits of addresses
+    uint64_t hash;
+    if constexpr(std::is_pointer_v<Key>)
+      hash = reinterpret_cast<uintptr_t>(key);
+    else
+      hash = key;
+    hash *= 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(hash >> 32) & mask();
+  }
+
+  size_t findBucket(const Key key) const
+  {
+    for(size_t i {bucketFor(key)}; m_buckets[i].slot != NO_SLOT; i = next(i)) {
+      if(m_buckets[i].key == key)
+        return i;
+    }
+
+    return NOT_FOUND;
+  }
+
+  void place(const Key key, const Slot slot)
+  {
+    size_t i {bucketFor(key)};
+    while(m_buckets[i].slot != NO_SLOT)
+      i = next(i);
+    m_buckets[i] = {key, slot};
+  }
+
+  void rehash(const size_t buckets)
+  {
+    std::vector<Bucket> old(buckets, Bucket {{}, NO_SLOT});
+    std::swap(old, m_buckets);
+    for(const Bucket &bucket : old) {
+      if(bucket.slot != NO_SLOT)
+        place(bucket.key, bucket.slot);
+    }
+  }
+
+  std::vector<Bucket> m_buckets;
+  size_t m_size {};
+};
+
+#endif
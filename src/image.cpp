@@ -20,6 +20,8 @@
 #include "color.hpp"
 #include "context.hpp"
 #include "error.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 #include "win32_unicode.hpp"
 
 #include <boost/iostreams/stream.hpp>
@@ -42,6 +44,7 @@ Image::RegisterType::RegisterType(const TestFunc test, const CreateFunc create)
 
 static Image *create(std::istream &stream)
 {
+  Trace::Zone zone {"Image::decode"};
   for(const Image::RegisterType *type {typeHead()}; type; type = type->m_next) {
     if(type->m_test(stream))
       return type->m_create(stream);
@@ -140,8 +143,9 @@ bool Bitmap::heartbeat()
 
   auto it {m_updates.begin()};
   while(it != m_updates.end()) {
-    // must leave 1 grace frame because Context's heartbeat may be called after ours
-    constexpr unsigned char UPDATE_TTL {Context::SUBRESOURCE_TTL + 1};
+    // contexts lagging further behind re-upload the whole texture
+    // (independent of their subresource TTL, which may be much longer)
+    constexpr unsigned char UPDATE_TTL {60};
     if(++it->age >= UPDATE_TTL)
       it = m_updates.erase(it);
     else
@@ -161,6 +165,9 @@ void Bitmap::copyPixels(int x, int y, unsigned int w, unsigned int h,
   std::conditional_t<Write, const reaper_array*, reaper_array*> pixels,
   unsigned int offset, unsigned int pitch)
 {
+  PROFILE_ZONE(Write ? "Bitmap::copyPixels (write)"
+                     : "Bitmap::copyPixels (read)");
+
   if(x >= m_width || y >= m_height)
     return;
 
@@ -212,6 +219,11 @@ ImTextureRef Bitmap::texture(Context *ctx)
   return ctx->touch<ImageTextureData>(this)->tex->GetTexRef();
 }
 
+size_t Bitmap::dataSize() const
+{
+  return m_pixels.capacity() + (m_updates.capacity() * sizeof(Update));
+}
+
 static void uninstall(Context *, ImageTextureData *data)
 {
   data->tex->Status = ImTextureStatus_WantDestroy;
@@ -231,22 +243,40 @@ SubresourceData Bitmap::install(Context *ctx)
   tex->Pixels = m_pixels.data();
   tex->RefCount = 1;
 
-  return {new ImageTextureData {tex, m_version}, &uninstall};
+  return {new ImageTextureData {tex, m_version}, &uninstall,
+    static_cast<size_t>(m_width) * m_height * 4};
 }
 
 void Bitmap::update(Context *, void *user)
 {
   auto data {static_cast<ImageTextureData *>(user)};
-  const auto prev {std::find_if(m_updates.rbegin(), m_updates.rend(),
-    [data](const Update &u) { return u.version == data->version; })};
   IM_ASSERT(data->tex->Updates.Size == 0);
-  for(auto it = prev.base(); it != m_updates.end(); ++it)
-    data->tex->Updates.push_back(it->rect);
+  if(data->version == m_version)
+    return;
+
+  // versions are sequential: check whether the next one is still in history
+  if(m_updates.empty() || m_updates.front().version > data->version + 1)
+    data->tex->Updates.push_back({0, 0, m_width, m_height});
+  else {
+    for(const Update &update : m_updates) {
+      if(update.version > data->version)
+        data->tex->Updates.push_back(update.rect);
+    }
+  }
   data->version = m_version;
   if(data->tex->Status == ImTextureStatus_OK && data->tex->Updates.Size > 0)
     data->tex->SetStatus(ImTextureStatus_WantUpdates);
 }
 
+ImageSet::~ImageSet()
+{
+  // members may have been destroyed first by Resource::destroyAll
+  for(const Item &item : m_images) {
+    if(Resource::exists(item.image))
+      item.image->unpin();
+  }
+}
+
 void ImageSet::add(const float scale, Image *img)
 {
   // don't allow infinite recursion
@@ -258,6 +288,7 @@ void ImageSet::add(const float scale, Image *img)
     throw reascript_error {"scale is already in the set"};
 
   m_images.emplace(it, scale, img);
+  img->pin();
 }
 
 const ImageSet::Item &ImageSet::select() const
@@ -295,14 +326,3 @@ ImTextureRef ImageSet::texture(Context *ctx)
 {
   return select().image->texture(ctx);
 }
-
-bool ImageSet::heartbeat()
-{
-  if(!Resource::heartbeat())
-    return false;
-
-  for(const auto &item : m_images)
-    item.image->keepAlive();
-
-  return true;
-}
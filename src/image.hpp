@@ -61,6 +61,7 @@ public:
   size_t width()  const override { return m_width;  }
   size_t height() const override { return m_height; }
   ImTextureRef texture(Context *) override;
+  size_t dataSize() const override;
 
   SubresourceData install(Context *) override;
   void update(Context *, void *) override;
@@ -95,15 +96,13 @@ public:
 
 class ImageSet final : public Image {
 public:
+  ~ImageSet();
   void add(float scale, Image *);
 
   size_t width() const override;
   size_t height() const override;
   ImTextureRef texture(Context *) override;
 
-protected:
-  bool heartbeat() override;
-
 private:
   struct Item {
     Item(float scale, Image *image) : image {image}, scale {scale} {}
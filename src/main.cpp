@@ -23,10 +23,13 @@
 
 #include "action.hpp"
 #include "api.hpp"
+#include "arena.hpp"
 #include "docker.hpp"
 #include "function.hpp"
+#include "profiler.hpp"
 #include "resource.hpp"
 #include "settings.hpp"
+#include "trace.hpp"
 #include "win32_unicode.hpp"
 #include "window.hpp"
 
@@ -158,12 +161,17 @@ extern "C" REAPER_PLUGIN_DLL_EXPORT int REAPER_PLUGIN_ENTRYPOINT(
     return 0;
 
   IMGUI_CHECKVERSION();
+  Arena::install();
 
   Window::s_instance = instance;
   API::setup();
   Action::setup();
   Settings::setup();
   Function::setup();
+  Trace::setup();
+#ifdef REAIMGUI_PROFILING
+  Profiler::setup();
+#endif
 
   new Action {"DOCUMENTATION", "Open ReaScript documentation (HTML)...", &openDocumentation};
 
@@ -20,6 +20,7 @@
 #include "context.hpp"
 #include "error.hpp"
 #include "import.hpp"
+#include "trace.hpp"
 #include "window.hpp"
 
 #include <AppKit/AppKit.h>
@@ -206,6 +207,7 @@ void MetalRenderer::Shared::processTexture(ImTextureData *tex)
 
 void MetalRenderer::Shared::createTexture(ImTextureData *tex)
 {
+  Trace::Zone zone {"Renderer::createTexture"};
   static ClassImport _MTLTextureDescriptor
     {METAL, "MTLTextureDescriptor"};
   if(!_MTLTextureDescriptor)
@@ -240,6 +242,7 @@ void MetalRenderer::Shared::createTexture(ImTextureData *tex)
 
 void MetalRenderer::Shared::updateTexture(ImTextureData *tex)
 {
+  Trace::Zone zone {"Renderer::updateTexture"};
   auto texture {(__bridge id<MTLTexture>)(void *)tex->GetTexID()};
   for(const ImTextureRect &rect : tex->Updates) {
     [texture replaceRegion:MTLRegionMake2D(rect.x, rect.y, rect.w, rect.h)
@@ -19,6 +19,8 @@
 
 #include "error.hpp"
 #include "context.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 #include "window.hpp"
 
 #ifdef __APPLE__
@@ -175,6 +177,7 @@ void OpenGLRenderer::Shared::processTexture(ImTextureData *tex)
 
 void OpenGLRenderer::Shared::createTexture(LocalTex &local, ImTextureData *tex)
 {
+  Trace::Zone zone {"Renderer::createTexture"};
   auto shared = static_cast<SharedTex *>(tex->BackendUserData);
   local.version = shared->version;
   ++shared->refCount;
@@ -193,6 +196,7 @@ void OpenGLRenderer::Shared::createTexture(LocalTex &local, ImTextureData *tex)
 
 void OpenGLRenderer::Shared::updateTexture(LocalTex &local, ImTextureData *tex)
 {
+  Trace::Zone zone {"Renderer::updateTexture"};
   local.version = reinterpret_cast<SharedTex *>(tex->BackendUserData)->version;
   glBindTexture(GL_TEXTURE_2D, local.id);
   glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width);
@@ -282,6 +286,8 @@ void OpenGLRenderer::teardown()
 
 void OpenGLRenderer::render(const bool flip)
 {
+  PROFILE_ZONE("OpenGLRenderer::render");
+
   const ImGuiViewport *viewport {m_window->viewport()};
   const ImDrawData *drawData {viewport->DrawData};
 
@@ -0,0 +1,78 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "platform.hpp"
+
+#include <chrono>
+#include <imgui/imgui.h>
+
+// Not every display configuration change comes with a notification
+// (eg. a panel resizing the work area on some Linux desktops).
+constexpr std::chrono::seconds MONITORS_REVALIDATE {2};
+
+// Shared by every context: the monitor list is the same for all of them.
+static ImVector<ImGuiPlatformMonitor> g_monitors, g_queried;
+static unsigned int g_monitorsGeneration;
+static bool g_monitorsInvalid {true};
+static std::chrono::steady_clock::time_point g_monitorsQueriedAt;
+
+static bool sameMonitor(const ImGuiPlatformMonitor &a, const ImGuiPlatformMonitor &b)
+{
+  // not using memcmp: the struct has padding before PlatformHandle
+  return a.MainPos.x  == b.MainPos.x  && a.MainPos.y  == b.MainPos.y  &&
+         a.MainSize.x == b.MainSize.x && a.MainSize.y == b.MainSize.y &&
+         a.WorkPos.x  == b.WorkPos.x  && a.WorkPos.y  == b.WorkPos.y  &&
+         a.WorkSize.x == b.WorkSize.x && a.WorkSize.y == b.WorkSize.y &&
+         a.DpiScale   == b.DpiScale   && a.PlatformHandle == b.PlatformHandle;
+}
+
+static bool sameMonitors(const ImVector<ImGuiPlatformMonitor> &a,
+                         const ImVector<ImGuiPlatformMonitor> &b)
+{
+  if(a.Size != b.Size)
+    return false;
+  for(int i {}; i < a.Size; ++i) {
+    if(!sameMonitor(a[i], b[i]))
+      return false;
+  }
+  return true;
+}
+
+void Platform::invalidateMonitors()
+{
+  g_monitorsInvalid = true;
+}
+
+void Platform::updateMonitors(unsigned int *generation)
+{
+  const auto now {std::chrono::steady_clock::now()};
+  if(g_monitorsInvalid || now - g_monitorsQueriedAt >= MONITORS_REVALIDATE) {
+    g_queried.resize(0); // recycle allocated memory (don't use clear here!)
+    queryMonitors(&g_queried);
+    if(!sameMonitors(g_queried, g_monitors)) {
+      g_monitors.swap(g_queried);
+      ++g_monitorsGeneration;
+    }
+    g_monitorsInvalid   = false;
+    g_monitorsQueriedAt = now;
+  }
+
+  if(*generation != g_monitorsGeneration) {
+    ImGui::GetPlatformIO().Monitors = g_monitors;
+    *generation = g_monitorsGeneration;
+  }
+}
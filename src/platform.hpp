@@ -26,14 +26,20 @@
 
 class DockerHost;
 class Window;
+struct ImGuiPlatformMonitor;
 struct ImGuiViewport;
 struct ImVec2;
+template<typename T> struct ImVector;
 typedef int ImGuiMouseCursor;
 
 namespace Platform {
   void install();
   Window *createWindow(ImGuiViewport *, DockerHost * = nullptr);
-  void updateMonitors();
+  // the monitor list is cached process-wide: updateMonitors copies it into the
+  // current context only when it changed since the given generation
+  void updateMonitors(unsigned int *generation);
+  void invalidateMonitors();
+  void queryMonitors(ImVector<ImGuiPlatformMonitor> *); // implemented per OS
   HWND windowFromPoint(ImVec2 nativePoint);
   ImVec2 getCursorPos(); // in native coordinates
   void scalePosition(ImVec2 *, bool toHiDpi = false, const ImGuiViewport * = nullptr);
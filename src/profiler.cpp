@@ -0,0 +1,119 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "profiler.hpp"
+
+#include "action.hpp"
+#include "error.hpp"
+#include "win32_unicode.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cinttypes>
+#include <cstring> // strerror
+#include <fstream>
+#include <vector>
+
+#include <reaper_plugin_functions.h>
+#include <WDL/wdltypes.h> // WDL_DIRCHAR_STR
+
+using namespace Profiler;
+
+static Zone *g_zones;
+
+Zone::Zone(const char *name)
+  : m_name {name}, m_count {}, m_total {}, m_max {}, m_buckets {},
+    m_next {g_zones}
+{
+  g_zones = this;
+}
+
+void Zone::record(const Clock::duration duration)
+{
+  const uint64_t ns
+    {static_cast<uint64_t>(std::chrono::nanoseconds {duration}.count())};
+  ++m_count;
+  m_total += ns;
+  m_max = std::max(m_max, ns);
+  ++m_buckets[std::min<unsigned int>(std::bit_width(ns), BUCKETS - 1)];
+}
+
+static void dumpZones()
+{
+  try {
+    const std::string file {"Profiling zones saved to " + dump(true)};
+    MessageBox(GetMainHwnd(), WIDEN(file.c_str()),
+      TEXT("ReaImGui"), MB_OK | MB_ICONINFORMATION);
+  }
+  catch(const reascript_error &e) {
+    MessageBox(GetMainHwnd(), WIDEN(e.what()),
+      TEXT("ReaImGui"), MB_OK | MB_ICONERROR);
+  }
+}
+
+void Profiler::setup()
+{
+  new Action {"PROFILE_DUMP", "Dump and reset profiling zones", &dumpZones};
+}
+
+std::string Profiler::dump(const bool reset)
+{
+  std::vector<Zone *> zones;
+  for(Zone *zone {g_zones}; zone; zone = zone->m_next) {
+    if(zone->m_count)
+      zones.push_back(zone);
+  }
+  std::sort(zones.begin(), zones.end(), [](const Zone *a, const Zone *b) {
+    return a->m_total > b->m_total;
+  });
+
+  const std::string path
+    {std::string {GetResourcePath()} + WDL_DIRCHAR_STR "imgui_profile.txt"};
+  std::ofstream stream {WIDEN(path.c_str())};
+  if(!stream.good())
+    throw reascript_error {"cannot write '{}': {}", path, strerror(errno)};
+
+  char line[256];
+  for(const Zone *zone : zones) {
+    snprintf(line, sizeof(line),
+      "%s\n  count %" PRIu64 ", total %.3f ms, mean %.3f us, max %.3f us\n",
+      zone->m_name, zone->m_count, zone->m_total / 1e6,
+      zone->m_total / 1e3 / zone->m_count, zone->m_max / 1e3);
+    stream << line;
+
+    // bucket N holds durations in [2^(N-1), 2^N) nanoseconds
+    for(unsigned int i {}; i < Zone::BUCKETS; ++i) {
+      if(!zone->m_buckets[i])
+        continue;
+      snprintf(line, sizeof(line), "  < %12.3f us %10" PRIu64 "\n",
+        static_cast<double>(uint64_t {1} << i) / 1e3, zone->m_buckets[i]);
+      stream << line;
+    }
+  }
+
+  if(!stream.good())
+    throw reascript_error {"cannot write '{}'", path};
+
+  if(reset) {
+    for(Zone *zone : zones) {
+      zone->m_count = zone->m_total = zone->m_max = 0;
+      std::fill(std::begin(zone->m_buckets), std::end(zone->m_buckets), 0);
+    }
+  }
+
+  return path;
+}
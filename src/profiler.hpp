@@ -0,0 +1,70 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_PROFILER_HPP
+#define REAIMGUI_PROFILER_HPP
+
+// Scoped timing zones compiled in by the 'profiling' build option.
+// Usage: PROFILE_ZONE("name"); at the top of a block.
+#ifdef REAIMGUI_PROFILING
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace Profiler {
+  using Clock = std::chrono::steady_clock;
+
+  void setup(); // registers the dump action
+  std::string dump(bool reset); // returns the path of the written file
+
+  // not synchronized: zones are only entered from the main thread
+  class Zone {
+  public:
+    static constexpr unsigned int BUCKETS {40}; // powers of two nanoseconds
+
+    Zone(const char *name);
+    void record(Clock::duration);
+
+  private:
+    friend std::string dump(bool);
+
+    const char *m_name;
+    uint64_t m_count, m_total, m_max; // nanoseconds
+    uint64_t m_buckets[BUCKETS];
+    Zone *m_next;
+  };
+
+  class Scope {
+  public:
+    Scope(Zone &zone) : m_zone {zone}, m_start {Clock::now()} {}
+    ~Scope() { m_zone.record(Clock::now() - m_start); }
+
+  private:
+    Zone &m_zone;
+    Clock::time_point m_start;
+  };
+};
+
+#  define PROFILE_ZONE(name)                       \
+     static Profiler::Zone profileZone {name};      \
+     Profiler::Scope profileScope {profileZone}
+#else
+#  define PROFILE_ZONE(name)
+#endif
+
+#endif
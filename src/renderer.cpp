@@ -17,11 +17,15 @@
 
 #include "renderer.hpp"
 
+#include "context.hpp"
 #include "settings.hpp"
+#include "trace.hpp"
 #include "viewport_forwarder.hpp"
 #include "window.hpp"
 
+#include <bit>
 #include <cassert>
+#include <cstring>
 #include <imgui/imgui.h>
 
 static auto &typeHead()
@@ -83,13 +87,13 @@ void Renderer::install()
   ImGuiPlatformIO &pio {ImGui::GetPlatformIO()};
   // pio.Renderer_CreateWindow  = &createViewport;
   // pio.Renderer_DestroyWindow = &destroyViewport;
-  pio.Renderer_SetWindowSize = &Forwarder::wrap<&Renderer::setSize>;
-  pio.Renderer_RenderWindow  = &Forwarder::wrap<&Renderer::render>;
-  pio.Renderer_SwapBuffers   = &Forwarder::wrap<&Renderer::swapBuffers>;
+  pio.Renderer_SetWindowSize = &Forwarder::wrap<&Renderer::setWindowSize>;
+  pio.Renderer_RenderWindow  = &Forwarder::wrap<&Renderer::renderWindow>;
+  pio.Renderer_SwapBuffers   = &Forwarder::wrap<&Renderer::swapWindowBuffers>;
 }
 
 Renderer::Renderer(Window *window)
-  : m_window {window}
+  : m_window {window}, m_skipSwap {false}
 {
   m_window->viewport()->RendererUserData = this;
 }
@@ -99,6 +103,114 @@ Renderer::~Renderer()
   m_window->viewport()->RendererUserData = nullptr;
 }
 
+static uint64_t hashBytes(uint64_t hash, const void *data, const size_t size)
+{
+  // fast non-cryptographic hash consuming 8 bytes per step
+  constexpr uint64_t K {0x9E3779B97F4A7C15ull};
+  const auto *bytes {static_cast<const unsigned char *>(data)};
+  size_t i {};
+  for(uint64_t word; i + sizeof(word) <= size; i += sizeof(word)) {
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (std::rotl(hash, 29) ^ word) * K;
+  }
+  uint64_t tail {size};
+  if(i < size)
+    std::memcpy(&tail, bytes + i, size - i);
+  return (std::rotl(hash, 29) ^ tail) * K;
+}
+
+static uint64_t fingerprint(const ImGuiViewport *viewport)
+{
+  const ImDrawData *drawData {viewport->DrawData};
+  const float geometry[] {viewport->DpiScale,
+    drawData->DisplayPos.x, drawData->DisplayPos.y,
+    drawData->DisplaySize.x, drawData->DisplaySize.y,
+    drawData->FramebufferScale.x, drawData->FramebufferScale.y};
+  uint64_t hash {hashBytes(0, geometry, sizeof(geometry))};
+
+  for(const ImDrawList *list : drawData->CmdLists) {
+    const auto &vertices {list->VtxBuffer};
+    const auto &indices  {list->IdxBuffer};
+    hash = hashBytes(hash, vertices.Data, vertices.size_in_bytes());
+    hash = hashBytes(hash, indices.Data, indices.size_in_bytes());
+    for(const ImDrawCmd &cmd : list->CmdBuffer) {
+      // field by field to not hash padding bytes
+      const uint64_t fields[] {
+        reinterpret_cast<uintptr_t>(cmd.TexRef._TexData), cmd.TexRef._TexID,
+        reinterpret_cast<uintptr_t>(cmd.UserCallback),
+        reinterpret_cast<uintptr_t>(cmd.UserCallbackData),
+        cmd.VtxOffset, cmd.IdxOffset, cmd.ElemCount,
+      };
+      hash = hashBytes(hash, &cmd.ClipRect, sizeof(cmd.ClipRect));
+      hash = hashBytes(hash, fields, sizeof(fields));
+    }
+  }
+
+  return hash;
+}
+
+bool PresentedFrame::hasTextureUpdates()
+{
+  for(const ImTextureData *tex : ImGui::GetPlatformIO().Textures) {
+    if(tex->Status != ImTextureStatus_OK)
+      return true;
+  }
+  return false;
+}
+
+bool PresentedFrame::unchanged(const ImGuiViewport *viewport,
+  const int frame, const bool texturesUpdated)
+{
+  // don't trust the presented contents after frames without rendering
+  // (eg. while minimized)
+  if(frame != m_lastFrame + 1)
+    m_presented.reset();
+  m_lastFrame = frame;
+
+  // texture uploads and deletions are performed while rendering
+  m_pending.reset();
+  if(!texturesUpdated)
+    m_pending = fingerprint(viewport);
+
+  if(m_pending && m_pending == m_presented)
+    return true;
+
+  m_presented.reset(); // in case rendering fails
+  return false;
+}
+
+void Renderer::setWindowSize(const ImVec2 size)
+{
+  m_presented.reset();
+  setSize(size);
+}
+
+void Renderer::renderWindow(void *userData)
+{
+  Context *ctx {m_window->context()};
+  m_skipSwap = m_presented.unchanged(m_window->viewport(),
+    ImGui::GetFrameCount(), ctx->texturesUpdated());
+  ctx->countRenderedFrame(m_skipSwap);
+  if(m_skipSwap)
+    return;
+
+  Trace::Zone zone {"Renderer::render", ctx->uniqId()};
+  render(userData);
+  m_presented.presented();
+}
+
+void Renderer::swapWindowBuffers(void *userData)
+{
+  if(m_skipSwap)
+    return;
+
+  Trace::Zone zone {"Renderer::swapBuffers", m_window->context()->uniqId()};
+  swapBuffers(userData);
+  // GDK has already drawn to the window in render(), or posted WM_PAINT
+  // when using the software blitting fallback
+  m_window->context()->framePresented();
+}
+
 Renderer::ProjMtx::ProjMtx(const ImVec2 &pos, const ImVec2 &size, const bool flip)
 {
   float L {pos.x},
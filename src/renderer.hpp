@@ -19,11 +19,14 @@
 #define REAIMGUI_RENDERER_HPP
 
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 class Renderer;
 class RendererFactory;
 class Window;
+struct ImGuiViewport;
 struct ImVec2;
 struct ImVec4;
 
@@ -67,6 +70,25 @@ private:
   bool m_forceSoftware;
 };
 
+// Fingerprint of the frame last presented in a viewport, to skip rendering
+// and presenting identical frames
+class PresentedFrame {
+public:
+  // whether any texture of the current context has pending updates
+  // (rendering any viewport performs them: check once per frame beforehand)
+  static bool hasTextureUpdates();
+
+  PresentedFrame() : m_lastFrame {-1} {}
+
+  bool unchanged(const ImGuiViewport *, int frame, bool texturesUpdated);
+  void presented() { m_presented = m_pending; }
+  void reset() { m_presented.reset(); }
+
+private:
+  std::optional<uint64_t> m_presented, m_pending;
+  int m_lastFrame;
+};
+
 class Renderer {
 public:
   static void install();
@@ -84,6 +106,13 @@ public:
   virtual void render(void *) = 0;
   virtual void swapBuffers(void *) = 0;
 
+  // platform callbacks: skip rendering and presenting unchanged frames
+  void setWindowSize(ImVec2);
+  void renderWindow(void *);
+  void swapWindowBuffers(void *);
+  // the presented contents were lost (eg. uncovered without composition)
+  void invalidate() { m_presented.reset(); }
+
 protected:
   class ProjMtx {
   public:
@@ -102,6 +131,10 @@ protected:
   };
 
   Window *m_window;
+
+private:
+  PresentedFrame m_presented;
+  bool m_skipSwap;
 };
 
 #define REGISTER_RENDERER(priority, id, name, creator, flags)   \
@@ -17,10 +17,18 @@
 
 #include "resource.hpp"
 
+#include "api.hpp"
 #include "configvar.hpp"
 #include "context.hpp"
 #include "error.hpp"
-
+#include "platform.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/core/demangle.hpp>
+#include <climits> // CHAR_BIT
 #include <functional>
 
 #include <reaper_plugin_functions.h>
@@ -37,6 +45,13 @@ constexpr unsigned char KEEP_ALIVE_FRAMES {2};
 // How many back-to-back GC frames to tolerate before complaining
 constexpr unsigned char MAX_GC_FRAMES {120};
 
+// How many ticks of churn history to keep for diagnostics
+constexpr size_t CHURN_HISTORY {120};
+
+// Above this many resources, heartbeats are spread over multiple timer ticks
+// (except for contexts, which must render a frame on every tick)
+constexpr size_t MAX_HEARTBEATS_PER_TICK {0x4000};
+
 enum GlobalFlags {
   MainProcOverriden = 1<<0,
   BypassGCCheckOnce = 1<<1,
@@ -49,9 +64,16 @@ enum ResourceFlags {
   BypassGCCheck = 1<<0,
 };
 
-FlatSet<Resource *> Resource::g_rsx;
+HandleTable<Resource> Resource::g_rsx;
+// first list holds resources whose dynamic type is not yet known
+std::vector<Resource::TypeList> Resource::g_types {{}};
 Resource::Timer *Resource::g_timer;
 
+static std::vector<Resource *> g_collected; // reused between ticks
+static std::vector<Resource::CensusRow> g_census;
+static std::array<Resource::ChurnSample, CHURN_HISTORY> g_churn;
+static size_t g_sweepCursor, g_ticks, g_censusTick {static_cast<size_t>(-1)};
+static unsigned int  g_createdThisTick;
 static unsigned int  g_reentrant, g_scriptRunCount, g_nextUniqId;
 static unsigned char g_consecutiveGcFrames, g_flags;
 static WNDPROC g_mainProc;
@@ -76,6 +98,7 @@ struct Resource::Timer {
   ~Timer();
 
   static void tick();
+  static void sweep(Resource *);
   static LRESULT CALLBACK mainProcOverride(HWND, unsigned int, WPARAM, LPARAM);
 };
 
@@ -83,7 +106,9 @@ Resource::Timer::Timer()
 {
   if(ConfigVar<unsigned int> runcnt {"__reascript_runcnt"})
     g_scriptRunCount = *runcnt;
-  else if(!(g_flags & MainProcOverriden)) {
+
+  // also needed to detect the end of defer cycles for low-latency contexts
+  if(!(g_flags & MainProcOverriden)) {
     LONG_PTR newProc {reinterpret_cast<LONG_PTR>(&mainProcOverride)},
              oldProc {SetWindowLongPtr(GetMainHwnd(), GWLP_WNDPROC, newProc)};
     g_mainProc = reinterpret_cast<WNDPROC>(oldProc);
@@ -108,6 +133,8 @@ Resource::Timer::~Timer()
 
 void Resource::Timer::tick()
 {
+  PROFILE_ZONE("Resource::Timer::tick");
+  Trace::Zone zone {"Timer::tick"};
   const bool blocked {isDeferLoopBlocked()};
 
 #ifndef __APPLE__
@@ -121,24 +148,50 @@ void Resource::Timer::tick()
   if(blocked)
     return;
 
-  auto it {g_rsx.begin()};
-  bool didGc {false};
-
-  while(it != g_rsx.end()) {
-    Resource *rs {*it};
-    if(rs->heartbeat())
-      ++it;
-    else {
-      didGc |= !(rs->m_flags & BypassGCCheck);
-      delete rs; // invalidates the iterator
-      it = g_rsx.lowerBound(rs);
+  if(g_rsx.size() <= MAX_HEARTBEATS_PER_TICK) {
+    // not using iterators: heartbeats may create new resources
+    for(size_t i {}; i < g_rsx.size(); ++i)
+      sweep(g_rsx[i]);
+    g_sweepCursor = 0;
+  }
+  else {
+    Resource::foreach<Context>(&sweep);
+
+    if(g_sweepCursor >= g_rsx.size())
+      g_sweepCursor = 0;
+    const size_t end
+      {std::min(g_rsx.size(), g_sweepCursor + MAX_HEARTBEATS_PER_TICK)};
+    for(; g_sweepCursor < end; ++g_sweepCursor) {
+      Resource *rs {g_rsx[g_sweepCursor]};
+      if(!rs->isInstanceOf<Context>())
+        sweep(rs);
     }
   }
 
+  // Collect after all heartbeats so that slots don't move during the pass.
+  // Each removal is constant-time, so a burst of N costs O(N).
+  bool didGc {false};
+  const auto collected {static_cast<unsigned int>(g_collected.size())};
+  for(Resource *rs : g_collected) {
+    didGc |= !(rs->m_flags & BypassGCCheck);
+    delete rs;
+  }
+  g_collected.clear();
+
   if(didGc)
     ++g_consecutiveGcFrames;
   else
     g_consecutiveGcFrames = 0;
+
+  g_churn[g_ticks++ % g_churn.size()] =
+    {g_createdThisTick, collected, g_consecutiveGcFrames};
+  g_createdThisTick = 0;
+}
+
+void Resource::Timer::sweep(Resource *rs)
+{
+  if(!rs->heartbeat())
+    g_collected.push_back(rs);
 }
 
 LRESULT CALLBACK Resource::Timer::mainProcOverride(HWND hwnd,
@@ -156,14 +209,27 @@ LRESULT CALLBACK Resource::Timer::mainProcOverride(HWND hwnd,
     const LRESULT ret {CallWindowProc(g_mainProc, hwnd, msg, wParam, lParam)};
     g_reentrant -= 1;
 
+    // every deferred script of this cycle has run by now
+    if(!g_reentrant)
+      Resource::foreach<Context>([](Context *ctx) { ctx->endDeferCycle(); });
+
     return ret;
   }
+#ifdef _WIN32
+  // only top-level windows receive these broadcasts
+  else if(msg == WM_DISPLAYCHANGE || msg == WM_DPICHANGED ||
+      (msg == WM_SETTINGCHANGE && wParam == SPI_SETWORKAREA))
+    Platform::invalidateMonitors();
+#endif
 
   return CallWindowProc(g_mainProc, hwnd, msg, wParam, lParam);
 }
 
 Resource::Resource()
-  : m_uniqId {g_nextUniqId++}, m_keepAlive {KEEP_ALIVE_FRAMES}, m_flags {}
+  : m_prev {}, m_next {}, m_creator {API::currentFunction()},
+    m_typeList {}, m_typesKnown {}, m_typesMatch {},
+    m_uniqId {g_nextUniqId++}, m_pins {}, m_keepAlive {KEEP_ALIVE_FRAMES},
+    m_flags {}
 {
   if(g_flags & BypassGCCheckOnce) {
     // < 0.9 backward compatibility
@@ -177,11 +243,14 @@ Resource::Resource()
     g_timer = new Timer;
 
   g_rsx.insert(this);
+  link(0);
+  ++g_createdThisTick;
 }
 
 Resource::~Resource()
 {
   g_rsx.erase(this);
+  unlink();
 
   if(g_rsx.empty()) {
     delete g_timer;
@@ -189,14 +258,68 @@ Resource::~Resource()
   }
 }
 
+void Resource::link(const unsigned short list)
+{
+  TypeList &head {g_types[list]};
+  m_typeList = list;
+  m_prev = nullptr;
+  m_next = head.head;
+  if(m_next)
+    m_next->m_prev = this;
+  head.head = this;
+}
+
+void Resource::unlink()
+{
+  TypeList &list {g_types[m_typeList]};
+  if(m_prev)
+    m_prev->m_next = m_next;
+  else
+    list.head = m_next;
+  if(m_next)
+    m_next->m_prev = m_prev;
+}
+
+const std::vector<Resource::TypeList> &Resource::typeLists()
+{
+  // The dynamic type is unknown to Resource's constructor: sort new resources
+  // into their type's list on the first lookup after they were constructed.
+  while(Resource *rs {g_types.front().head}) {
+    const std::type_info &type {typeid(*rs)};
+    auto it {std::find_if(g_types.begin() + 1, g_types.end(),
+      [&type](const TypeList &list) { return *list.type == type; })};
+    if(it == g_types.end())
+      it = g_types.insert(it, {&type, nullptr});
+
+    rs->unlink();
+    rs->link(it - g_types.begin());
+  }
+
+  return g_types;
+}
+
 void Resource::keepAlive()
 {
   m_keepAlive = KEEP_ALIVE_FRAMES;
 }
 
+void Resource::pin()
+{
+  ++m_pins;
+}
+
+void Resource::unpin()
+{
+  assert(m_pins > 0);
+  if(!--m_pins)
+    keepAlive(); // start counting down from the last use by the owner
+}
+
 bool Resource::heartbeat()
 {
-  if(m_keepAlive < 0)
+  if(m_pins)
+    return true;
+  else if(m_keepAlive < 0)
     return false;
 
   --m_keepAlive;
@@ -211,6 +334,57 @@ bool Resource::isValid() const
   return m_keepAlive >= 0;
 }
 
+Resource::TypeMask Resource::nextTypeBit()
+{
+  // types past the capacity of the mask are resolved using RTTI on every query
+  static unsigned int nextBit;
+  if(nextBit >= sizeof(TypeMask) * CHAR_BIT)
+    return 0;
+  return TypeMask {1} << nextBit++;
+}
+
+const std::vector<Resource::CensusRow> &Resource::census()
+{
+  // rebuilt at most once per tick: only costs anything while being watched
+  if(g_censusTick == g_ticks)
+    return g_census;
+
+  g_census.clear();
+  for(const TypeList &list : typeLists()) {
+    const size_t firstRow {g_census.size()};
+    for(const Resource *rs {list.head}; rs; rs = rs->m_next) {
+      auto row {std::find_if(g_census.begin() + firstRow, g_census.end(),
+        [rs](const CensusRow &row) { return row.creator == rs->m_creator; })};
+      if(row == g_census.end()) {
+        g_census.push_back({{}, rs->m_creator, 0, 0});
+        row = g_census.end() - 1;
+      }
+      ++row->count;
+      row->bytes += rs->dataSize();
+    }
+    if(g_census.size() > firstRow) {
+      const std::string type {boost::core::demangle(list.type->name())};
+      for(auto it {g_census.begin() + firstRow}; it != g_census.end(); ++it)
+        it->type = type;
+    }
+  }
+
+  g_censusTick = g_ticks;
+  return g_census;
+}
+
+const Resource::ChurnSample *Resource::churn(const unsigned int ticksAgo)
+{
+  if(ticksAgo >= std::min(g_ticks, g_churn.size()))
+    return nullptr;
+  return &g_churn[(g_ticks - 1 - ticksAgo) % g_churn.size()];
+}
+
+size_t Resource::tickCount()
+{
+  return g_ticks;
+}
+
 void Resource::destroyAll()
 {
   while(!g_rsx.empty())
@@ -21,32 +21,39 @@
 #include <cassert>
 
 #include "../api/types.hpp"
-#include "flat_set.hpp"
+#include "handle_table.hpp"
+
+#include <string>
+#include <typeinfo>
+#include <vector>
 
 class Context;
 
 class SubresourceData {
 public:
   template<typename T>
-  SubresourceData(T *data, void (*uninstaller)(Context *, T *))
+  SubresourceData(T *data, void (*uninstaller)(Context *, T *), size_t size = 0)
     : m_ptr {data},
-      m_deleter {reinterpret_cast<void(*)(Context *, void *)>(uninstaller)}
+      m_deleter {reinterpret_cast<void(*)(Context *, void *)>(uninstaller)},
+      m_size {size}
   {}
   SubresourceData(const SubresourceData &) = delete;
   SubresourceData(SubresourceData &&o) noexcept { *this = std::move(o); }
   SubresourceData &operator=(SubresourceData &&o) noexcept {
-    m_ptr = o.m_ptr, m_deleter = o.m_deleter;
+    m_ptr = o.m_ptr, m_deleter = o.m_deleter, m_size = o.m_size;
     o.m_ptr = nullptr;
     return *this;
   }
   ~SubresourceData() { assert(!m_ptr); };
 
   operator void *() const { return m_ptr; }
+  size_t size() const { return m_size; } // approximate memory usage in bytes
   void uninstall(Context *ctx) { m_deleter(ctx, m_ptr); m_ptr = nullptr; }
 
 private:
   void *m_ptr;
   void (*m_deleter)(Context *, void *);
+  size_t m_size;
 };
 
 class Resource {
@@ -55,8 +62,25 @@ public:
   Resource(const Resource &) = delete;
   virtual ~Resource();
 
+  struct CensusRow {
+    std::string type;
+    const char *creator; // API function or nullptr if created internally
+    size_t count, bytes;
+  };
+
+  struct ChurnSample {
+    unsigned int created, collected;
+    unsigned char gcFrames; // consecutive ticks with collections so far
+  };
+
   void keepAlive();
+  void pin();   // keep alive until unpinned (eg. by an owner)
+  void unpin();
   unsigned int uniqId() const { return m_uniqId; }
+  const char *creator() const { return m_creator; }
+
+  // approximate heap memory owned by the object, excluding itself
+  virtual size_t dataSize() const { return 0; }
 
   virtual bool attachable(const Context *) const = 0;
 
@@ -68,21 +92,36 @@ public:
   static bool isValid(T *userData)
   {
     if constexpr(std::is_same_v<Resource, std::remove_const_t<T>>)
-      return g_rsx.contains(const_cast<Resource *>(userData)) && userData->isValid();
+      return g_rsx.contains(userData) && userData->isValid();
 
     auto resource {static_cast<const Resource *>(userData)};
     return isValid(resource) && resource->isInstanceOf<T>();
   }
 
   template<typename T, typename Fn>
-  static void foreach(const Fn &&callback) // O(n) of all types, not per type
+  static void foreach(const Fn &&callback) // O(n) of matching types only
   {
-    for(Resource *rs : g_rsx) {
-      if(rs->isInstanceOf<T>())
+    for(const TypeList &list : typeLists()) {
+      if(!list.head || !list.head->isInstanceOf<T>())
+        continue;
+      for(Resource *rs {list.head}, *next; rs; rs = next) {
+        next = rs->m_next;
         callback(static_cast<T *>(rs));
+      }
     }
   }
 
+  // whether the object was not destroyed yet, valid or not
+  static bool exists(const Resource *rs) { return g_rsx.contains(rs); }
+
+  // live objects grouped by dynamic type and creator (built on demand)
+  static const std::vector<CensusRow> &census();
+  // per-tick counters, ticksAgo=0 is the last completed tick
+  static const ChurnSample *churn(unsigned int ticksAgo);
+
+  // number of completed timer ticks (constant during heartbeats)
+  static size_t tickCount();
+
   static void destroyAll();
   static void bypassGCCheckOnce();
   static void testHeartbeat();
@@ -90,8 +129,19 @@ public:
   template<typename T>
   bool isInstanceOf() const
   {
-    // short-circuiting dynamic_cast for faster exact type match
-    return typeid(*this) == typeid(T) || dynamic_cast<const T *>(this);
+    // RTTI is only consulted on the first query for each type,
+    // subsequent ones are answered from the object's type tag
+    const TypeMask bit {typeBit<std::remove_cv_t<T>>()};
+    if(!(m_typesKnown & bit)) {
+      const bool match
+        {typeid(*this) == typeid(T) || dynamic_cast<const T *>(this)};
+      if(!bit)
+        return match;
+      m_typesKnown |= bit;
+      if(match)
+        m_typesMatch |= bit;
+    }
+    return m_typesMatch & bit;
   }
 
 protected:
@@ -100,11 +150,35 @@ protected:
 
 private:
   struct Timer;
+  using TypeMask = uint32_t;
+
+  static TypeMask nextTypeBit();
+  template<typename T>
+  static TypeMask typeBit()
+  {
+    static const TypeMask bit {nextTypeBit()};
+    return bit;
+  }
+
+  // intrusive list of every resource sharing the same dynamic type
+  struct TypeList {
+    const std::type_info *type;
+    Resource *head;
+  };
+
+  static const std::vector<TypeList> &typeLists();
+  void link(unsigned short list);
+  void unlink();
 
-  static FlatSet<Resource *> g_rsx;
+  static HandleTable<Resource> g_rsx;
+  static std::vector<TypeList> g_types;
   static Timer *g_timer;
 
-  unsigned int m_uniqId;
+  Resource *m_prev, *m_next;
+  const char *m_creator;
+  unsigned short m_typeList;
+  mutable TypeMask m_typesKnown, m_typesMatch;
+  unsigned int m_uniqId, m_pins;
   signed char m_keepAlive;
   unsigned char m_flags;
 };
@@ -0,0 +1,69 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "slab.hpp"
+
+#include <array>
+#include <new>
+
+constexpr size_t GRANULARITY {alignof(std::max_align_t)},
+                 MAX_BLOCK_SIZE {512}, SLAB_SIZE {16 * 1024};
+
+static std::array<SizeClass, MAX_BLOCK_SIZE / GRANULARITY> g_classes;
+
+static size_t classIndex(const size_t size)
+{
+  return (size + GRANULARITY - 1) / GRANULARITY - 1;
+}
+
+void *SizeClass::allocate(const size_t blockSize, const size_t slabSize)
+{
+  if(!m_free) {
+    const size_t count {slabSize / blockSize};
+    std::byte *slab {new std::byte[count * blockSize]};
+    m_slabs.emplace_back(slab);
+    m_reserved += count * blockSize;
+    for(size_t i {count}; i-- > 0;)
+      deallocate(slab + (i * blockSize));
+  }
+
+  FreeBlock *block {m_free};
+  m_free = block->next;
+  return block;
+}
+
+void SizeClass::deallocate(void *ptr) noexcept
+{
+  m_free = new(ptr) FreeBlock {m_free};
+}
+
+void *SlabAllocator::allocate(const size_t size)
+{
+  if(size > MAX_BLOCK_SIZE)
+    return ::operator new(size);
+
+  const size_t index {classIndex(size)};
+  return g_classes[index].allocate((index + 1) * GRANULARITY, SLAB_SIZE);
+}
+
+void SlabAllocator::deallocate(void *ptr, const size_t size) noexcept
+{
+  if(size > MAX_BLOCK_SIZE)
+    ::operator delete(ptr);
+  else
+    g_classes[classIndex(size)].deallocate(ptr);
+}
@@ -0,0 +1,56 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_SLAB_HPP
+#define REAIMGUI_SLAB_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Fixed-size blocks carved out of larger slabs and recycled in LIFO order.
+// Slabs are kept until the size class is destroyed (bounded by peak usage).
+class SizeClass {
+public:
+  void *allocate(size_t blockSize, size_t slabSize);
+  void deallocate(void *) noexcept;
+  size_t reserved() const { return m_reserved; } // bytes in slabs
+
+private:
+  struct FreeBlock { FreeBlock *next; };
+
+  std::vector<std::unique_ptr<std::byte[]>> m_slabs;
+  FreeBlock *m_free {};
+  size_t m_reserved {};
+};
+
+// Process-wide size classes for small objects, slabs are kept for the
+// lifetime of the process. Main thread only.
+namespace SlabAllocator {
+  void *allocate(size_t size);
+  void deallocate(void *ptr, size_t size) noexcept;
+};
+
+// opt-in for objects that scripts typically create and drop every frame
+struct Pooled {
+  static void *operator new(size_t size)
+    { return SlabAllocator::allocate(size); }
+  static void operator delete(void *ptr, size_t size) noexcept
+    { SlabAllocator::deallocate(ptr, size); }
+};
+
+#endif
@@ -0,0 +1,251 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "trace.hpp"
+
+#include "action.hpp"
+#include "context.hpp"
+#include "error.hpp"
+#include "win32_unicode.hpp"
+
+#include <array>
+#include <cstring> // strerror
+#include <ctime>
+#include <fstream>
+#include <vector>
+
+#include <reaper_plugin_functions.h>
+#include <WDL/wdltypes.h> // WDL_DIRCHAR_STR
+
+struct Event {
+  const char *name;
+  unsigned int track;
+  Trace::Clock::time_point start, end;
+};
+
+// Events are appended without locking by the thread owning the buffer.
+// Readers only see the events published by the release store of size.
+struct Chunk {
+  static constexpr size_t CAPACITY {4096};
+  std::array<Event, CAPACITY> events;
+  std::atomic<size_t> size;
+  std::atomic<Chunk *> next;
+};
+
+// Never freed: threads are few (usually only REAPER's main thread).
+struct ThreadBuffer {
+  static constexpr size_t MAX_CHUNKS {256}; // ~1M events per thread
+
+  void push(const Event &);
+
+  unsigned int tid;
+  std::atomic<unsigned int> session; // written by the owner thread only
+  size_t chunks;
+  Chunk *head, *tail;
+  ThreadBuffer *next;
+};
+
+std::atomic<bool> Trace::g_recording;
+static std::atomic<ThreadBuffer *> g_buffers;
+static std::atomic<unsigned int> g_session, g_threads;
+static Trace::Clock::time_point g_startTime;
+static std::vector<std::pair<unsigned int, std::string>> g_tracks;
+static Action *g_action;
+
+void ThreadBuffer::push(const Event &event)
+{
+  const unsigned int current {g_session.load(std::memory_order_acquire)};
+  if(session.load(std::memory_order_relaxed) != current) {
+    // recycle the chunks of the previous recording
+    for(Chunk *chunk {head}; chunk; chunk = chunk->next.load(std::memory_order_relaxed))
+      chunk->size.store(0, std::memory_order_relaxed);
+    tail = head;
+    session.store(current, std::memory_order_release);
+  }
+
+  size_t size {tail->size.load(std::memory_order_relaxed)};
+  if(size == Chunk::CAPACITY) {
+    if(Chunk *next {tail->next.load(std::memory_order_relaxed)})
+      tail = next;
+    else if(chunks < MAX_CHUNKS) {
+      Chunk *chunk {new Chunk {}};
+      ++chunks;
+      tail->next.store(chunk, std::memory_order_release);
+      tail = chunk;
+    }
+    else
+      return; // full: drop the event
+    size = 0;
+  }
+
+  tail->events[size] = event;
+  tail->size.store(size + 1, std::memory_order_release);
+}
+
+static ThreadBuffer *threadBuffer()
+{
+  thread_local ThreadBuffer *buffer;
+  if(buffer)
+    return buffer;
+
+  Chunk *chunk {new Chunk {}};
+  buffer = new ThreadBuffer {++g_threads, g_session.load(), 1, chunk, chunk, nullptr};
+  buffer->next = g_buffers.load(std::memory_order_relaxed);
+  while(!g_buffers.compare_exchange_weak(buffer->next, buffer,
+    std::memory_order_release, std::memory_order_relaxed));
+  return buffer;
+}
+
+void Trace::complete(const char *name, const unsigned int track,
+  const Clock::time_point start, const Clock::time_point end)
+{
+  if(isRecording())
+    threadBuffer()->push({name, track, start, end});
+}
+
+static void toggle()
+{
+  try {
+    if(!Trace::isRecording()) {
+      Trace::start();
+      return;
+    }
+
+    const std::string file {"The trace was saved to " + Trace::stop()};
+    MessageBox(GetMainHwnd(), WIDEN(file.c_str()),
+      TEXT("ReaImGui"), MB_OK | MB_ICONINFORMATION);
+  }
+  catch(const reascript_error &e) {
+    MessageBox(GetMainHwnd(), WIDEN(e.what()),
+      TEXT("ReaImGui"), MB_OK | MB_ICONERROR);
+  }
+}
+
+void Trace::setup()
+{
+  g_action = new Action {"TRACE", "Record a performance trace (toggle)",
+    &toggle, &isRecording};
+}
+
+void Trace::nameTrack(const unsigned int track, const char *name)
+{
+  if(isRecording())
+    g_tracks.emplace_back(track, name);
+}
+
+void Trace::start()
+{
+  if(isRecording())
+    return;
+
+  g_tracks.clear();
+  g_startTime = Clock::now();
+  g_session.fetch_add(1, std::memory_order_release);
+  g_recording.store(true, std::memory_order_release);
+  Resource::foreach<Context>([](Context *ctx) {
+    nameTrack(ctx->uniqId(), ctx->name());
+  });
+
+  if(g_action)
+    g_action->refresh();
+}
+
+static void writeString(std::ostream &stream, const char *str)
+{
+  stream << '"';
+  for(; *str; ++str) {
+    const unsigned char c = *str;
+    if(c == '"' || c == '\\')
+      stream << '\\' << c;
+    else if(c < 0x20)
+      stream << ' ';
+    else
+      stream << c;
+  }
+  stream << '"';
+}
+
+static void writeEvents(std::ostream &stream)
+{
+  constexpr int THREADS_PID {1}, CONTEXTS_PID {2};
+  const unsigned int session {g_session.load(std::memory_order_acquire)};
+  const auto micros {[](const Trace::Clock::duration d) {
+    return std::chrono::duration<double, std::micro> {d}.count();
+  }};
+
+  stream << R"({"displayTimeUnit":"ms","traceEvents":[)" "\n";
+  stream << R"({"name":"process_name","ph":"M","pid":1,"args":{"name":"ReaImGui"}},)" "\n";
+  stream << R"({"name":"process_name","ph":"M","pid":2,"args":{"name":"Contexts"}})";
+  for(const auto &[track, name] : g_tracks) {
+    stream << ",\n" << R"({"name":"thread_name","ph":"M","pid":2,"tid":)"
+           << track << R"(,"args":{"name":)";
+    writeString(stream, name.c_str());
+    stream << "}}";
+  }
+
+  for(const ThreadBuffer *buffer {g_buffers.load(std::memory_order_acquire)};
+      buffer; buffer = buffer->next) {
+    // the owner thread sets the session before publishing events
+    if(buffer->session.load(std::memory_order_acquire) != session)
+      continue;
+
+    for(const Chunk *chunk {buffer->head}; chunk;
+        chunk = chunk->next.load(std::memory_order_acquire)) {
+      const size_t size {chunk->size.load(std::memory_order_acquire)};
+      for(size_t i {}; i < size; ++i) {
+        const Event &event {chunk->events[i]};
+        const bool onContext {event.track != 0};
+        stream << ",\n{\"name\":";
+        writeString(stream, event.name);
+        stream << R"(,"ph":"X","pid":)" << (onContext ? CONTEXTS_PID : THREADS_PID)
+               << R"(,"tid":)" << (onContext ? event.track : buffer->tid)
+               << R"(,"ts":)" << micros(event.start - g_startTime)
+               << R"(,"dur":)" << micros(event.end - event.start) << '}';
+      }
+    }
+  }
+
+  stream << "\n]}\n";
+}
+
+std::string Trace::stop()
+{
+  if(!isRecording())
+    return {};
+
+  g_recording.store(false, std::memory_order_release);
+  if(g_action)
+    g_action->refresh();
+
+  const std::time_t now {std::time(nullptr)};
+  char fileName[64];
+  std::strftime(fileName, sizeof(fileName),
+    "imgui_trace_%Y%m%d-%H%M%S.json", std::localtime(&now));
+  const std::string path
+    {std::string {GetResourcePath()} + WDL_DIRCHAR_STR + fileName};
+
+  std::ofstream stream {WIDEN(path.c_str())};
+  if(!stream.good())
+    throw reascript_error {"cannot write '{}': {}", path, strerror(errno)};
+  stream.precision(3);
+  stream << std::fixed;
+  writeEvents(stream);
+  if(!stream.good())
+    throw reascript_error {"cannot write '{}'", path};
+
+  return path;
+}
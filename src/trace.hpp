@@ -0,0 +1,62 @@
+/* ReaImGui: ReaScript binding for Dear ImGui
+ * Copyright (C) 2021-2025  Christian Fillion
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef REAIMGUI_TRACE_HPP
+#define REAIMGUI_TRACE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+
+// Opt-in timeline recorder writing Chrome/Perfetto trace-event JSON.
+// Track 0 is the recording thread's, other tracks are contexts (by uniqId).
+namespace Trace {
+  using Clock = std::chrono::steady_clock;
+
+  extern std::atomic<bool> g_recording;
+  inline bool isRecording() { return g_recording.load(std::memory_order_relaxed); }
+
+  void setup(); // registers the toggle action
+  void start();
+  std::string stop(); // returns the path of the written file
+  void nameTrack(unsigned int track, const char *name);
+  void complete(const char *name, unsigned int track,
+                Clock::time_point start, Clock::time_point end);
+
+  class Zone {
+  public:
+    Zone(const char *name, unsigned int track = 0)
+      : m_name {isRecording() ? name : nullptr}, m_track {track}
+    {
+      if(m_name)
+        m_start = Clock::now();
+    }
+
+    ~Zone()
+    {
+      if(m_name)
+        complete(m_name, m_track, m_start, Clock::now());
+    }
+
+  private:
+    const char *m_name; // static string
+    unsigned int m_track;
+    Clock::time_point m_start;
+  };
+};
+
+#endif
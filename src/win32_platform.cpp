@@ -97,7 +97,7 @@ Window *Platform::createWindow(ImGuiViewport *viewport, DockerHost *dockerHost)
   return new Win32Window {viewport, dockerHost};
 }
 
-static int CALLBACK enumMonitors(HMONITOR monitor, HDC, LPRECT, LPARAM)
+static int CALLBACK enumMonitors(HMONITOR monitor, HDC, LPRECT, LPARAM param)
 {
   MONITORINFO info {.cbSize = sizeof(MONITORINFO)};
   if(!GetMonitorInfo(monitor, &info))
@@ -124,19 +124,19 @@ static int CALLBACK enumMonitors(HMONITOR monitor, HDC, LPRECT, LPARAM)
   imguiMonitor.WorkSize.x /= imguiMonitor.DpiScale;
   imguiMonitor.WorkSize.y /= imguiMonitor.DpiScale;
 
-  ImGuiPlatformIO &pio {ImGui::GetPlatformIO()};
+  auto monitors {reinterpret_cast<ImVector<ImGuiPlatformMonitor> *>(param)};
   if(info.dwFlags & MONITORINFOF_PRIMARY)
-    pio.Monitors.push_front(imguiMonitor);
+    monitors->push_front(imguiMonitor);
   else
-    pio.Monitors.push_back(imguiMonitor);
+    monitors->push_back(imguiMonitor);
 
   return true;
 }
 
-void Platform::updateMonitors()
+void Platform::queryMonitors(ImVector<ImGuiPlatformMonitor> *monitors)
 {
-  ImGui::GetPlatformIO().Monitors.resize(0);
-  EnumDisplayMonitors(nullptr, nullptr, enumMonitors, 0);
+  EnumDisplayMonitors(nullptr, nullptr, enumMonitors,
+    reinterpret_cast<LPARAM>(monitors));
 }
 
 static HWND windowBehind(HWND candidate, const POINT point)
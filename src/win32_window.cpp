@@ -371,6 +371,7 @@ std::optional<LRESULT> Win32Window::handleMessage
       return MA_NOACTIVATE;
     break;
   case WM_DPICHANGED: {
+    Platform::invalidateMonitors();
     m_dpi = LOWORD(wParam);
     m_viewport->DpiScale = scaleForDpi(m_dpi);
 
@@ -382,7 +383,7 @@ std::optional<LRESULT> Win32Window::handleMessage
 
     // imgui won't call this if unscaled size didn't change
     if(m_renderer)
-      m_renderer->setSize(getSize());
+      m_renderer->setWindowSize(getSize());
     return 0;
   }
   case WM_DPICHANGED_BEFOREPARENT:
@@ -393,6 +394,11 @@ std::optional<LRESULT> Win32Window::handleMessage
     m_viewport->Pos = getPosition();
     // WM_SIZE has been sent, no need to set m_viewport->Size here
     return 0;
+  case WM_PAINT: // uncovered without DWM composition
+  case WM_SIZE:
+    if(m_renderer)
+      m_renderer->invalidate();
+    break; // validated by DefWindowProc
   case WM_GETDLGCODE:
     return DLGC_WANTALLKEYS; // eat all inputs, don't let Tab steal focus
   case WM_XBUTTONDOWN:
@@ -126,6 +126,9 @@ LRESULT CALLBACK Window::proc(HWND handle, const unsigned int msg,
 #endif
     self->m_ctx->mouseWheel(msg == WM_MOUSEHWHEEL, GET_WHEEL_DELTA_WPARAM(wParam));
     return 0;
+  case WM_MOUSEMOVE: // the position itself is polled once per frame
+    self->m_ctx->inputReceived();
+    break;
   case WM_SETCURSOR:
     if(LOWORD(lParam) == HTCLIENT) {
       SetCursor(self->m_ctx->cursor()); // sets the cursor when re-entering the window
@@ -234,7 +237,13 @@ bool Window::hasFocus() const
 bool Window::isMinimized() const
 {
   // IsWindowVisible is false when docked and another tab is active
-  return !IsWindowVisible(m_hwnd);
+  if(!IsWindowVisible(m_hwnd))
+    return true;
+
+  // eg. docker shrunk to nothing by a splitter
+  RECT rect;
+  GetClientRect(m_hwnd, &rect);
+  return rect.right <= rect.left || rect.bottom <= rect.top;
 }
 
 void Window::mouseDown(const ImGuiMouseButton btn)
@@ -0,0 +1,63 @@
+#include "../src/arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+
+TEST(ArenaTest, Stats) {
+  Arena::Ptr arena {Arena::create()};
+  void *small {Arena::allocate(arena.get(), 24)},
+       *large {Arena::allocate(arena.get(), 64 * 1024)};
+  ASSERT_NE(small, nullptr);
+  ASSERT_NE(large, nullptr);
+
+  const Arena::Stats &stats {arena->stats()};
+  EXPECT_EQ(stats.bytes, 24u + (64 * 1024));
+  EXPECT_EQ(stats.blocks, 2u);
+  EXPECT_EQ(stats.allocations, 2u);
+  EXPECT_GT(stats.reserved, stats.bytes);
+
+  Arena::deallocate(small);
+  Arena::deallocate(large);
+  EXPECT_EQ(stats.bytes, 0u);
+  EXPECT_EQ(stats.blocks, 0u);
+  EXPECT_EQ(stats.allocations, 2u);
+}
+
+TEST(ArenaTest, ReuseFreedBlocks) {
+  Arena::Ptr arena {Arena::create()};
+  void *a {Arena::allocate(arena.get(), 40)};
+  const size_t reserved {arena->stats().reserved};
+  Arena::deallocate(a);
+
+  void *b {Arena::allocate(arena.get(), 33)};
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(arena->stats().reserved, reserved);
+  Arena::deallocate(b);
+}
+
+TEST(ArenaTest, Alignment) {
+  Arena::Ptr arena {Arena::create()};
+  for(size_t size {1}; size < 1024; size += 7) {
+    void *ptr {Arena::allocate(arena.get(), size)};
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t), 0u);
+    std::memset(ptr, 0xff, size);
+    Arena::deallocate(ptr);
+  }
+}
+
+TEST(ArenaTest, Unpooled) {
+  void *ptr {Arena::allocate(nullptr, 16)};
+  ASSERT_NE(ptr, nullptr);
+  Arena::deallocate(ptr);
+  Arena::deallocate(nullptr);
+}
+
+TEST(ArenaTest, OutliveRelease) {
+  Arena::Ptr arena {Arena::create()};
+  void *ptr {Arena::allocate(arena.get(), 16)};
+  arena.reset(); // deleted once the last block is freed
+  std::memset(ptr, 0xff, 16);
+  Arena::deallocate(ptr);
+}
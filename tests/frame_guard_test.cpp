@@ -0,0 +1,93 @@
+#include "../api/helper.hpp"
+
+#include <gtest/gtest.h>
+
+#include <new>
+
+// bumps the epoch on destruction and when a frame ends and makes its ImGui
+// context current when entering a frame like Context does
+struct FakeContext : Resource {
+  static unsigned int frameEpoch() { return epoch; }
+
+  FakeContext() : m_imgui { ImGui::CreateContext() } {}
+  ~FakeContext() { ImGui::DestroyContext(m_imgui); ++epoch; }
+  bool attachable(const Context *) const override { return false; }
+  ImGuiContext *imgui() const { return m_imgui; }
+  bool enterFrame()
+  {
+    ImGui::SetCurrentContext(m_imgui);
+    ++frames;
+    return true;
+  }
+  void endFrame() { ++epoch; }
+
+  static unsigned int epoch;
+  int frames { 0 };
+
+private:
+  ImGuiContext *m_imgui;
+};
+
+API_REGISTER_OBJECT_TYPE(FakeContext);
+
+unsigned int FakeContext::epoch;
+
+TEST(FrameGuardTest, SkipWhileInFrame) {
+  FakeContext ctx;
+  frameGuard(&ctx);
+  frameGuard(&ctx);
+  EXPECT_EQ(ctx.frames, 1);
+
+  ctx.endFrame();
+  frameGuard(&ctx);
+  EXPECT_EQ(ctx.frames, 2);
+}
+
+TEST(FrameGuardTest, OtherContext) {
+  FakeContext a, b;
+  frameGuard(&a);
+  frameGuard(&b);
+  frameGuard(&a);
+  EXPECT_EQ(a.frames, 2);
+  EXPECT_EQ(b.frames, 1);
+}
+
+TEST(FrameGuardTest, OtherCurrentImGuiContext) {
+  FakeContext ctx;
+  frameGuard(&ctx);
+  EXPECT_EQ(ImGui::GetCurrentContext(), ctx.imgui());
+
+  // eg. switched by another extension calling into ImGui directly
+  ImGuiContext *other { ImGui::CreateContext() };
+  ImGui::SetCurrentContext(other);
+  frameGuard(&ctx);
+  EXPECT_EQ(ctx.frames, 2);
+  EXPECT_EQ(ImGui::GetCurrentContext(), ctx.imgui());
+
+  frameGuard(&ctx);
+  EXPECT_EQ(ctx.frames, 2);
+
+  ImGui::DestroyContext(other);
+}
+
+TEST(FrameGuardTest, ReusedAddress) {
+  alignas(FakeContext) std::byte storage[sizeof(FakeContext)];
+
+  FakeContext *first {new (storage) FakeContext};
+  frameGuard(first);
+  EXPECT_EQ(first->frames, 1);
+  first->~FakeContext();
+
+  FakeContext *second {new (storage) FakeContext};
+  ASSERT_EQ(first, second);
+  frameGuard(second);
+  EXPECT_EQ(second->frames, 1);
+  second->~FakeContext();
+}
+
+TEST(FrameGuardTest, Destroyed) {
+  FakeContext *ctx {new FakeContext};
+  frameGuard(ctx);
+  delete ctx;
+  EXPECT_THROW(frameGuard(ctx), reascript_error);
+}
@@ -0,0 +1,146 @@
+#include "../src/hash_index.hpp"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+
+using Index = HashIndex<unsigned int>;
+
+// keys whose home is the last of the initial buckets (mirrors bucketFor)
+static std::vector<unsigned int> keysHomedAtEnd(const size_t count)
+{
+  std::vector<unsigned int> keys;
+  for(unsigned int key {}; keys.size() < count; ++key) {
+    const uint64_t hash {key * 0x9E3779B97F4A7C15ull};
+    if(((hash >> 32) & 63) == 63)
+      keys.push_back(key);
+  }
+  return keys;
+}
+
+TEST(HashIndexTest, Empty) {
+  Index index;
+  EXPECT_EQ(index.size(), 0u);
+  EXPECT_EQ(index.find(42), Index::NO_SLOT);
+}
+
+TEST(HashIndexTest, InsertFind) {
+  Index index;
+  index.insert(42, 0);
+  index.insert(7, 1);
+  EXPECT_EQ(index.size(), 2u);
+  EXPECT_EQ(index.find(42), 0u);
+  EXPECT_EQ(index.find(7), 1u);
+  EXPECT_EQ(index.find(8), Index::NO_SLOT);
+}
+
+TEST(HashIndexTest, Assign) {
+  Index index;
+  index.insert(42, 0);
+  index.assign(42, 5);
+  EXPECT_EQ(index.find(42), 5u);
+  EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(HashIndexTest, Erase) {
+  Index index;
+  index.insert(42, 0);
+  index.insert(7, 1);
+  index.erase(42);
+  EXPECT_EQ(index.find(42), Index::NO_SLOT);
+  EXPECT_EQ(index.find(7), 1u);
+  EXPECT_EQ(index.size(), 1u);
+}
+
+TEST(HashIndexTest, Pointers) {
+  int values[2] {};
+  HashIndex<const int *> index;
+  index.insert(&values[0], 0);
+  index.insert(&values[1], 1);
+  EXPECT_EQ(index.find(&values[1]), 1u);
+  index.erase(&values[0]);
+  EXPECT_EQ(index.find(&values[0]), HashIndex<const int *>::NO_SLOT);
+  EXPECT_EQ(index.find(&values[1]), 1u);
+}
+
+TEST(HashIndexTest, WrapAround) {
+  const std::vector<unsigned int> keys {keysHomedAtEnd(3)};
+  Index index;
+  for(unsigned int i {}; i < keys.size(); ++i)
+    index.insert(keys[i], i);
+
+  // the second and third keys are stored past the end (at the start)
+  index.erase(keys[0]);
+  EXPECT_EQ(index.find(keys[0]), Index::NO_SLOT);
+  EXPECT_EQ(index.find(keys[1]), 1u);
+  EXPECT_EQ(index.find(keys[2]), 2u);
+
+  index.erase(keys[1]);
+  EXPECT_EQ(index.find(keys[2]), 2u);
+  index.insert(keys[0], 3);
+  EXPECT_EQ(index.find(keys[0]), 3u);
+  EXPECT_EQ(index.find(keys[2]), 2u);
+}
+
+TEST(HashIndexTest, Rehash) {
+  Index index;
+  for(unsigned int i {}; i < 1000; ++i)
+    index.insert(i * 3, i);
+  EXPECT_EQ(index.size(), 1000u);
+  for(unsigned int i {}; i < 1000; ++i) {
+    ASSERT_EQ(index.find(i * 3), i);
+    ASSERT_EQ(index.find((i * 3) + 1), Index::NO_SLOT);
+  }
+}
+
+TEST(HashIndexTest, Clear) {
+  Index index;
+  index.insert(42, 0);
+  index.clear();
+  EXPECT_EQ(index.size(), 0u);
+  EXPECT_EQ(index.find(42), Index::NO_SLOT);
+  index.insert(42, 1);
+  EXPECT_EQ(index.find(42), 1u);
+}
+
+TEST(HashIndexTest, MatchesMap) {
+  std::mt19937 rng {42};
+  std::uniform_int_distribution<unsigned int> keyDist {0, 500}, opDist {0, 2};
+  std::map<unsigned int, Index::Slot> expected;
+  Index index;
+
+  for(int op {}; op < 100'000; ++op) {
+    const unsigned int key {keyDist(rng)};
+    const bool exists {expected.count(key) > 0};
+    switch(opDist(rng)) {
+    case 0:
+      if(exists)
+        break;
+      index.insert(key, op);
+      expected[key] = op;
+      break;
+    case 1:
+      if(!exists)
+        break;
+      index.assign(key, op);
+      expected[key] = op;
+      break;
+    case 2:
+      if(!exists)
+        break;
+      index.erase(key);
+      expected.erase(key);
+      break;
+    }
+
+    ASSERT_EQ(index.size(), expected.size());
+    const auto it {expected.find(key)};
+    ASSERT_EQ(index.find(key), it == expected.end() ? Index::NO_SLOT : it->second);
+  }
+
+  for(unsigned int key {}; key <= 500; ++key) {
+    const auto it {expected.find(key)};
+    ASSERT_EQ(index.find(key), it == expected.end() ? Index::NO_SLOT : it->second);
+  }
+}
@@ -0,0 +1,47 @@
+#include "../src/renderer.hpp"
+
+#include <gtest/gtest.h>
+#include <imgui/imgui.h>
+
+TEST(RendererTest, TextureUpdateInTwoViewports) {
+  ImGuiContext *imgui {ImGui::CreateContext()};
+  ImGuiPlatformIO &pio {ImGui::GetPlatformIO()};
+  ImTextureData texture;
+  pio.Textures.push_back(&texture);
+
+  ImDrawData drawData;
+  ImGuiViewport viewports[2];
+  PresentedFrame presented[2];
+  for(ImGuiViewport &viewport : viewports)
+    viewport.DrawData = &drawData;
+
+  // the first viewport to render performs the texture updates, like backends
+  const auto present {[&](const int frame) {
+    const bool texturesUpdated {PresentedFrame::hasTextureUpdates()};
+    unsigned int rendered {};
+    for(size_t i {}; i < std::size(viewports); ++i) {
+      if(presented[i].unchanged(&viewports[i], frame, texturesUpdated))
+        continue;
+      texture.Status = ImTextureStatus_OK;
+      presented[i].presented();
+      ++rendered;
+    }
+    return rendered;
+  }};
+
+  texture.Status = ImTextureStatus_OK;
+  EXPECT_EQ(present(1), 2u);
+  EXPECT_EQ(present(2), 0u);
+
+  texture.Status = ImTextureStatus_WantUpdates;
+  EXPECT_EQ(present(3), 2u);
+  EXPECT_EQ(present(4), 2u); // frames with texture updates are not hashed
+  EXPECT_EQ(present(5), 0u);
+
+  presented[1].reset();
+  EXPECT_EQ(present(6), 1u);
+  EXPECT_EQ(present(8), 2u); // a frame was not rendered
+
+  pio.Textures.clear();
+  ImGui::DestroyContext(imgui);
+}
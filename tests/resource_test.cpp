@@ -1,7 +1,10 @@
 #include "../src/resource.hpp"
 
+#include "../src/api.hpp"
 #include "../src/error.hpp"
+#include "../src/slab.hpp"
 
+#include <cstring>
 #include <gtest/gtest.h>
 
 struct Foo : Resource {
@@ -25,6 +28,10 @@ struct Lifetime : Resource {
   int *m_alive;
 };
 
+struct PooledLifetime : Lifetime, Pooled {
+  using Lifetime::Lifetime;
+};
+
 TEST(ResourceTest, ValidateNull) {
   auto foo { std::make_unique<Foo>() };
   EXPECT_FALSE(Resource::isValid<Foo>(nullptr));
@@ -70,6 +77,30 @@ TEST(ResourceTest, ValidateVoid) {
   EXPECT_FALSE(Resource::isValid<void>(foo.get()));
 }
 
+TEST(ResourceTest, ValidateManyLive) {
+  std::vector<std::unique_ptr<Resource>> objects;
+  for(int i {}; i < 10'000; ++i) {
+    if(i & 1)
+      objects.emplace_back(std::make_unique<Bar>());
+    else
+      objects.emplace_back(std::make_unique<Baz>());
+  }
+
+  for(size_t i {}; i < objects.size(); i += 2) {
+    const void *ptr {objects[i].get()};
+    objects[i].reset();
+    EXPECT_FALSE(Resource::isValid(static_cast<const Baz *>(ptr)));
+  }
+
+  for(size_t i {1}; i < objects.size(); i += 2) {
+    auto bar {static_cast<Bar *>(objects[i].get())};
+    EXPECT_TRUE(Resource::isValid<Foo>(bar));
+    EXPECT_TRUE(Resource::isValid<Bar>(bar));
+    EXPECT_FALSE(Resource::isValid<Baz>(
+      static_cast<Baz *>(static_cast<void *>(bar))));
+  }
+}
+
 TEST(ResourceTest, ForeachBase) {
   Foo foo; Bar bar; Baz baz;
 
@@ -111,6 +142,72 @@ TEST(ResourceTest, GarbageCollection) {
   EXPECT_EQ(alive, 0);
 }
 
+TEST(ResourceTest, Pin) {
+  int alive {};
+  auto res = new Lifetime { &alive };
+  res->pin();
+  res->pin();
+  for(int i {}; i < 1024; ++i) {
+    Resource::testHeartbeat();
+    ASSERT_TRUE(Resource::isValid(res));
+  }
+
+  res->unpin();
+  Resource::testHeartbeat();
+  EXPECT_TRUE(Resource::isValid(res));
+
+  res->unpin();
+  for(int i {}; i <= 2; ++i) {
+    EXPECT_TRUE(Resource::isValid(res));
+    Resource::testHeartbeat();
+    ASSERT_EQ(alive, 1);
+  }
+  EXPECT_FALSE(Resource::isValid(res));
+  Resource::testHeartbeat();
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(ResourceTest, CollectBurst) {
+  int alive {};
+  for(int i {}; i < 5'000; ++i)
+    new Lifetime { &alive };
+  for(int i {}; i <= 2; ++i)
+    Resource::testHeartbeat();
+  EXPECT_EQ(alive, 5'000);
+  Resource::testHeartbeat();
+  EXPECT_EQ(alive, 0);
+}
+
+TEST(ResourceTest, IncrementalCollection) {
+  Foo timer;
+
+  int alive {};
+  for(int i {}; i < 50'000; ++i)
+    new Lifetime { &alive };
+
+  for(int i {}; i < 1'000 && alive > 0; ++i) {
+    ASSERT_TRUE(Resource::isValid(&timer));
+    timer.keepAlive();
+    Resource::testHeartbeat();
+  }
+  EXPECT_EQ(alive, 0);
+  EXPECT_TRUE(Resource::isValid(&timer));
+}
+
+TEST(ResourceTest, PooledRecycling) {
+  int alive {};
+  auto first {new PooledLifetime { &alive }};
+  const void *firstAddr {first};
+  delete first;
+  EXPECT_EQ(alive, 0);
+  EXPECT_FALSE(Resource::isValid(static_cast<const Resource *>(firstAddr)));
+
+  auto second {new PooledLifetime { &alive }};
+  EXPECT_EQ(static_cast<const void *>(second), firstAddr);
+  EXPECT_TRUE(Resource::isValid(second));
+  delete second;
+}
+
 TEST(ResourceTest, MaxGCFrames) {
   Foo timer;
 
@@ -132,3 +229,46 @@ TEST(ResourceTest, MaxGCFrames) {
 
   EXPECT_THROW({ Foo foo; }, reascript_error);
 }
+
+TEST(ResourceTest, Census) {
+  std::vector<std::unique_ptr<Baz>> objs;
+  {
+    API::CallScope scope {"CreateBaz"};
+    for(int i {}; i < 3; ++i)
+      objs.push_back(std::make_unique<Baz>());
+  }
+  objs.push_back(std::make_unique<Baz>());
+  Resource::testHeartbeat(); // census is rebuilt at most once per tick
+
+  size_t fromApi {}, internal {};
+  for(const Resource::CensusRow &row : Resource::census()) {
+    if(row.type != "Baz")
+      continue;
+    else if(row.creator && !strcmp(row.creator, "CreateBaz"))
+      fromApi += row.count;
+    else if(!row.creator)
+      internal += row.count;
+  }
+  EXPECT_EQ(fromApi, 3u);
+  EXPECT_EQ(internal, 1u);
+}
+
+TEST(ResourceTest, Churn) {
+  auto foo {std::make_unique<Foo>()};
+  foo->pin();
+  Resource::testHeartbeat(); // reset the counters
+
+  int alive {};
+  for(int i {}; i < 2; ++i)
+    new Lifetime { &alive };
+  Resource::testHeartbeat();
+  EXPECT_EQ(Resource::churn(0)->created, 2u);
+  EXPECT_EQ(Resource::churn(0)->collected, 0u);
+
+  while(alive)
+    Resource::testHeartbeat();
+  EXPECT_EQ(Resource::churn(0)->created, 0u);
+  EXPECT_EQ(Resource::churn(0)->collected, 2u);
+  EXPECT_EQ(Resource::churn(0)->gcFrames, 1);
+  EXPECT_EQ(Resource::churn(1)->collected, 0u);
+}